@@ -113,7 +113,7 @@ void loop() {
 
 
 // Sample Service-Handler
-void handleLed(uint8_t subserviceNumber, uint8_t payload[], uint8_t payloadCount, uint8_t sourceAddress) {
+void handleLed(uint8_t subserviceNumber, const uint8_t payload[], uint8_t payloadCount, uint8_t sourceAddress) {
   devSerialDebug.println(F("AdvMaster:\tThis is LED Service Callback on Master"));                                    // Write some Debug-Output (you can use the same Interface for your own Output)
 
   if (rgbValue[subserviceNumber] < 128) {                                                                             // Toggle the RGB-LED Value based on Subservice
@@ -142,7 +142,7 @@ void handleLed(uint8_t subserviceNumber, uint8_t payload[], uint8_t payloadCount
 
 
 // Sample CatchAll-Handler
-void handleAll(uint8_t serviceNumber, uint8_t subserviceNumber, uint8_t payload[], uint8_t payloadCount, uint8_t sourceAddress) {
+void handleAll(uint8_t serviceNumber, uint8_t subserviceNumber, const uint8_t payload[], uint8_t payloadCount, uint8_t sourceAddress) {
   devSerialDebug.print(F("AdvMaster:\tThis is UNIVERSAL (CatchAll) Service Callback on Master, called from 0x"));                   // Write some Debug-Output (you can use the same Interface for your own Output)
 	debugPrintHex(sourceAddress);
       devSerialDebug.println();
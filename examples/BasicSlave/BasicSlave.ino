@@ -83,7 +83,7 @@ void loop() {
 
 
 // Sample Function Handler
-void handleLed(uint8_t subserviceNumber, uint8_t payload[], uint8_t payloadCount, uint8_t sourceAddress) {
+void handleLed(uint8_t subserviceNumber, const uint8_t payload[], uint8_t payloadCount, uint8_t sourceAddress) {
   devSerialDebug.print(F("This is LED Service Callback for Subservice:0x"));                                          // Write some Debug-Output (you can use the same Interface for your own Output)
   devSerialDebug.print(subserviceNumber, HEX);
   devSerialDebug.print(F("\t Payload:"));
@@ -0,0 +1,184 @@
+/*  GN Master Slave Universal Protocol Library - Exaple: SimulatorBenchmark
+ *  =======================================================================
+ *
+ *  Library for generic Master/Slave Communications.
+ *  Host-Benchmark (Linux, no Arduino): one Master and 30 Slaves on a simulated RS485 Line (gnMsup1Simulator) with a
+ *  virtual Clock. Every Scenario polls like the Basic-/AdvancedMaster Examples while the Slaves push timestamped
+ *  Messages, and reports Frames/s, Line-Utilisation and Push-Latency Percentiles (in virtual Time, reproducible).
+ *
+ *  Build & Run (from the Library Folder):
+ *    g++ -std=c++11 -O2 -Isrc examples/SimulatorBenchmark/SimulatorBenchmark.cpp src/gnMsup1*.cpp -pthread -o benchmark
+ *    ./benchmark [BaudRate] [BitErrorRate]
+ *
+ *  MIT License
+ *
+ *  Copyright (c) 2018 Andreas Gloor
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+
+
+#include <gnMsup1.h>                                                                                                  // Include MSUP Library
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+
+
+
+#define SLAVES              30                                                                                        // Slaves on the Line (Addresses 1..SLAVES)
+#define DURATION            10000000ull                                                                               // Virtual Time per Scenario in Microseconds
+#define PUSHINTERVAL        100000ul                                                                                  // Every Slave pushes a Message per Interval (Microseconds)
+#define MAXSAMPLES          ((DURATION / PUSHINTERVAL + 1) * SLAVES)
+
+
+
+enum Engine {PollRange, StartPoll, StartScheduler};                                                                   // How the Master polls (see README)
+
+struct Scenario {
+  const char*           name;
+  gnMsup1::BlockingMode mode;
+  Engine                engine;
+};
+
+const Scenario scenarios[] = {
+  {"Synchronous        pollRange     ", gnMsup1::Synchronous,        PollRange},                                        // Like AdvancedMaster, blocking
+  {"NearlyAsynchronous pollRange     ", gnMsup1::NearlyAsynchronous, PollRange},                                        // Like AdvancedMaster (Default-Mode)
+  {"FullyAsynchronous  startPoll     ", gnMsup1::FullyAsynchronous,  StartPoll},                                        // Poll-Engine from handleCommunication
+#ifdef GNMSUP1_POLLSCHEDULER
+  {"FullyAsynchronous  startScheduler", gnMsup1::FullyAsynchronous,  StartScheduler},                                   // Adaptive Poll-Scheduler
+#endif
+};
+
+uint32_t latencies[MAXSAMPLES];                                                                                       // Push-Latency per delivered Message (Microseconds)
+uint32_t latencyCount = 0;
+
+
+
+void handleMessage(uint8_t, const uint8_t payload[], uint8_t payloadSize, uint8_t) {                                 // Master: Message of a Slave, Payload = its Push-Timestamp
+  if (payloadSize == 4 && latencyCount < MAXSAMPLES) {
+    uint32_t pushed = ((uint32_t)payload[0] << 24) | ((uint32_t)payload[1] << 16) | ((uint32_t)payload[2] << 8) | payload[3];
+    latencies[latencyCount++] = micros() - pushed;
+  }
+}
+
+
+
+double percentile(double share) {                                                                                     // Latency in ms of a sorted Share (0..1)
+  if (latencyCount == 0) {
+    return 0;
+  }
+  uint32_t index = (uint32_t)(share * (latencyCount - 1) + 0.5);
+  return latencies[index] / 1000.0;
+}
+
+
+
+void runScenario(const Scenario& scenario, uint32_t baudRate, double bitErrorRate) {
+  gnMsup1Simulator simulator(baudRate, bitErrorRate);                                                                 // First the Simulator: the Buses read its Clock when constructed
+  gnMsup1SimulatedTransport* transports = new gnMsup1SimulatedTransport[SLAVES + 1];
+  gnMsup1* nodes[SLAVES + 1];
+
+  nodes[0] = new gnMsup1(transports[0], gnMsup1::Master);                                                             // Setup the Master like AdvancedMaster
+  simulator.attach(*nodes[0], transports[0]);
+  nodes[0]->attachService(0x11, handleMessage);
+  nodes[0]->setIgnoreInactiveNodes(true);
+  nodes[0]->blockingMode(scenario.mode);
+  nodes[0]->begin(baudRate);
+
+  uint32_t pushTimer[SLAVES + 1];
+  for (uint8_t i = 1; i <= SLAVES; i++) {                                                                             // Setup the Slaves; their Push-Timers staggered over the Interval
+    nodes[i] = new gnMsup1(transports[i], gnMsup1::Slave);
+    simulator.attach(*nodes[i], transports[i]);
+    nodes[i]->blockingMode(scenario.mode == gnMsup1::Synchronous ? gnMsup1::NearlyAsynchronous : scenario.mode);      // Synchronous Push would wait for the Master
+    nodes[i]->begin(baudRate, i);
+    pushTimer[i] = micros() + PUSHINTERVAL * i / SLAVES;
+  }
+
+  latencyCount = 0;
+  uint32_t pushed = 0;
+  while (simulator.now() < DURATION) {
+    simulator.run(1000);                                                                                              // 1 ms of Bus-Traffic, then the "Sketch"-Code
+
+    for (uint8_t i = 1; i <= SLAVES; i++) {                                                                           // Slaves: push a timestamped Message every Interval
+      if ((int32_t)(micros() - pushTimer[i]) >= 0) {
+        pushTimer[i] += PUSHINTERVAL;
+        uint32_t now = micros();
+        uint8_t payload[4] = {(uint8_t)(now >> 24), (uint8_t)(now >> 16), (uint8_t)(now >> 8), (uint8_t)now};
+        if (nodes[i]->push(0x11, 0x01, payload, 4)) {
+          pushed++;
+        }
+      }
+    }
+
+    switch (scenario.engine) {                                                                                        // Master: keep polling the whole Range
+      case PollRange:
+        nodes[0]->pollRange(1, SLAVES, 2, true, true);
+        break;
+      case StartPoll:
+        if (!nodes[0]->pollActive()) {
+          nodes[0]->startPoll(1, SLAVES, 2, true);
+        }
+        break;
+      case StartScheduler:
+#ifdef GNMSUP1_POLLSCHEDULER
+        if (!nodes[0]->schedulerActive()) {
+          nodes[0]->startScheduler(1, SLAVES, 2, true);
+        }
+#endif
+        break;
+    }
+  }
+
+  uint64_t frames = 0;                                                                                                // Report
+  uint64_t crErrors = 0;
+#ifdef GNMSUP1_STATISTICS
+  for (uint8_t i = 1; i <= SLAVES; i++) {
+    gnMsup1::Statistics statistics;
+    nodes[0]->statistics(i, statistics);
+    frames += statistics.framesSent + statistics.framesReceived;
+    crErrors += statistics.crTimeouts + statistics.crInvalid;
+  }
+#endif
+  std::sort(latencies, latencies + latencyCount);
+  double seconds = simulator.now() / 1000000.0;
+  printf("%s %8.0f %6.1f%% %7lu/%-7lu %7.1f %7.1f %7.1f %7.1f %6llu %6llu\n", scenario.name,
+         frames / seconds, simulator.utilisation() * 100, (unsigned long)latencyCount, (unsigned long)pushed,
+         percentile(0.5), percentile(0.9), percentile(0.99), percentile(1.0),
+         (unsigned long long)crErrors, (unsigned long long)simulator.bitErrors());
+
+  for (uint8_t i = 0; i <= SLAVES; i++) {
+    delete nodes[i];
+  }
+  delete[] transports;
+}
+
+
+
+int main(int argc, char* argv[]) {
+  uint32_t baudRate = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 115200;
+  double bitErrorRate = (argc > 2) ? strtod(argv[2], nullptr) : 0.000001;
+
+  printf("%u Slaves, %lu Baud, Bit-Error-Rate %g, %llu s virtual Time per Scenario\n\n", SLAVES, (unsigned long)baudRate, bitErrorRate, DURATION / 1000000ull);
+  printf("Scenario                            Frames/s   Line   Delivered/Pushed  p50 ms  p90 ms  p99 ms  max ms  CRErr BitErr\n");
+  for (uint8_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+    runScenario(scenarios[i], baudRate, bitErrorRate);
+  }
+  return 0;
+}
@@ -5,6 +5,7 @@
  *  
  *  THIS IS THE USER-CONFIG FILE.
  *	Edit this File to customize the Protocol to you requirements.
+ *	The Limits below are the Defaults of every Bus (gnMsup1Config); a single Instance can be sized differently by gnMsup1Bus<Config>.
  *  
  *  2018-09-12  V1.2.1		Andreas Gloor            Bugfix pollRange (for FullyAsynchonous) and pushBlockingActive public; handleCommunication called if data available before send
  *  2018-08-24  V1.1.1		Andreas Gloor            SourceAddress Parameter in Callback Function
@@ -40,9 +41,45 @@
 #define GNMSUP1_DEFAULTBAUDRATE							9600								// Default Bitrate (can be overwritten in the begin call)
 #define GNMSUP1_MAXPAYLOADBUFFER						8										// Uses Memory, align to maximum Payload-Size
 #define GNMSUP1_FRAMELENGHTTIMEOUT					30									// Defines the Frameout Time as N-Times of (ideal) FrameTime. Use only integer Values. To aggressive Values produce Drops on slow Systems. To conservative Values reduces in excessive waits on transmission errors. In an ideal world you can use 1. That's very aggressive. When one Node has Debug enabled, i recommend to use at least 25. With 30 you are in a save Area and you still have low Performance impact. These Values are valid for 115200 Baud (RS485 AND Debug-Port Speed). Slower Baudrates allow to use lower Factors, because the Node has more time to process between two Bytes.
-#define GNMSUP1_DEFAULTPUSHQEUETIMEOUT			20000ul							// Timeout in Milliseconds for a Pushmessage to stay in qeue
-#define GNMSUP1_MAXPUSHQEUEENTRYS						10									// Deep of the Push-Qeue; uses n * (8 + GNMSUP1_MAXPAYLOADBUFFER) Bytes; 254 max
-#define GNMSUP1_MAXSERVICECOUNT							10									// 3 Bytes per Service
+#define GNMSUP1_DEFAULTPUSHQEUETIMEOUT			20000ul							// Timeout in Milliseconds for a Pushmessage to stay in qeue (unless push() sets its own Lifetime)
+#define GNMSUP1_MAXPUSHQEUEENTRYS						10									// Deep of the Push-Qeue; uses n * (12 + GNMSUP1_MAXPAYLOADBUFFER) Bytes; 32767 max
+#define GNMSUP1_MAXSERVICECOUNT							10									// Services per Node (attachService) for the Hash-Table; ~5 Bytes per Service. Not limited with GNMSUP1_DIRECTSERVICETABLE
+#ifndef __AVR__
+	#define GNMSUP1_DIRECTSERVICETABLE																						// Dispatch Services by a 256-Entry Table (one Pointer per Entry); comment out to use the small Hash-Table. Off on AVR to save RAM
+#endif
 #define GNMSUP1_PUSHTIMEOUT									50									// Time in ms for a Slave to answer a Push-Request; Measured after sending the StartBytes of the PushRequest (so include time for process the potential payloaded Frame, prior to answer the push request.)
 #define GNMSUP1_MAXSLAVEADDRESS							0x1F								// Limits the maximum Count of Slaves to reduce memory requirements of the library
-#define GNMSUP1_SCAVENGINGINACTIVEINTERVAL	10000								// Period after inactive (ignored) Nodes would be rescanned	
\ No newline at end of file
+#ifndef __AVR__
+	#define GNMSUP1_POLLSCHEDULER																									// Adaptive Poll-Scheduler (startScheduler); ~8 Bytes per Slave-Address. Off on AVR to save RAM
+#endif
+#ifndef __AVR__
+	#define GNMSUP1_STATISTICS																										// Counters and Latency-Histograms per Slave-Address (statistics()); ~100 Bytes per Slave-Address. Off on AVR to save RAM
+#endif
+#define GNMSUP1_STATISTICSBUCKETS						8										// Statistics: Buckets per Latency-Histogram; Bucket n counts Latencies below GNMSUP1_STATISTICSBUCKETMICROS << n, the last one the Rest
+#define GNMSUP1_STATISTICSBUCKETMICROS			500									// Statistics: Upper Limit of the first Bucket in Microseconds
+#ifndef __AVR__
+	#define GNMSUP1_ADAPTIVETIMEOUTS																							// Push-, CR- and Frame-Timeouts per Slave learned from its Turnaround (like TCP); 18 Bytes per Slave-Address. Off on AVR to save RAM
+#endif
+#define GNMSUP1_ADAPTIVEFLOORMICROS					1000								// Adaptive Timeouts: least Turnaround (or Gaps within a Frame) in Microseconds a learned Timeout allows, on top of the Time on the Line; the fixed Timeouts are the Ceiling
+#define GNMSUP1_ADAPTIVESAMPLES							8										// Adaptive Timeouts: Samples of a Slave before its learned Timeouts apply
+#define GNMSUP1_SCHEDULERFLOORINTERVAL			1000								// Poll-Scheduler: every Slave gets polled at least once per Interval (ms), even if idle
+#define GNMSUP1_SCHEDULERMAXWEIGHT					8										// Poll-Scheduler: a busy Slave gets polled up to n-times as often as an idle one (Fairness)
+#define GNMSUP1_TRANSFERWINDOW							8										// Segmented Transfer (startTransfer): Segments sent per Acknowledge; 16 max. Larger Windows save Turnarounds, smaller ones resend less on a noisy Bus
+#define GNMSUP1_TRANSFERRETRIES							3										// Segmented Transfer: Windows resent without Progress, before the Transfer fails
+#define GNMSUP1_BAUDSWITCHWINDOW						3000								// Baudrate-Switch (startBaudrateSwitch): Slaves fall back to the old Baudrate unless the Master confirms within n ms; 65535 max
+#define GNMSUP1_BAUDSWITCHSETTLE						20									// Baudrate-Switch: Pause in ms after the Switch, before the Master talks at the new Rate (Slaves reconfigure their UART)
+#define GNMSUP1_BAUDSWITCHREPEAT						2										// Baudrate-Switch: Copies of the broadcast Switch-Command; a Slave missing all of them makes the Switch fall back
+#define GNMSUP1_BAUDSWITCHRETRIES						2										// Baudrate-Switch: Resends of a Verify- or Commit-Request per Slave
+#define GNMSUP1_MAXREGISTERMAPSIZE					64									// Register-Map (gnMsup1RegisterMap): largest Map in Bytes; costs 1 Dirty-Bit per Byte and Map
+#define GNMSUP1_SCAVENGINGINACTIVEINTERVAL	2000								// Period after inactive (ignored) Nodes would be rescanned	
+#define GNMSUP1_SCAVENGINGBUDGET						4										// Scavenging: failed Probes per Interval (answering Nodes don't count); lost Nodes first, the last one Round-Robin
+#define GNMSUP1_PROBETIMEOUT								20									// Discovery and Scavenging: Turnaround allowed for a Probe in ms, on top of the Echo's Time on the Line (if shorter than the CommitReceive-Timeout)
+#define GNMSUP1_RXCHUNKSIZE									16									// Bytes drained from the Serial-Port per Step and fed to the Frame-Decoder at once; 255 max
+#define GNMSUP1_BUSMANAGER_MAXBUSES					8										// POSIX Bus-Manager only: Buses (Serial-Ports) per Manager
+#define GNMSUP1_BUSMANAGER_TASKQUEUE				16									// POSIX Bus-Manager only: posted Tasks waiting per Bus
+#define GNMSUP1_SIMULATOR_MAXNODES					32									// POSIX Simulator only: Nodes (Master and Slaves) on the simulated Line
+#define GNMSUP1_SIMULATOR_RXBUFFER					512									// POSIX Simulator only: Bytes queued per Node, not yet read
+#define GNMSUP1_SIMULATOR_PROCESSINGMICROS	10									// POSIX Simulator only: virtual Time a Pass over the Nodes costs at least (CPU-Time)
+#define GNMSUP1_SIMULATOR_SPINREADS					4										// POSIX Simulator only: empty Reads within one Step before the Node counts as waiting (blocking)
+#define GNMSUP1_POSIX_RXBUFFER							256									// POSIX Transport only: Size of the Bulk Receive-Buffer (Bytes fetched per read() System-Call)
+#define GNMSUP1_POSIX_HANGUPRETRY						100									// POSIX Transport only: Sleep in ms while the Port reports a Hang-up or Error (e.g. Pty without Peer), before poll() checks it again
@@ -47,52 +47,173 @@
 
 
 // Internal defines
-#define GNMSUP1_NOTINSTORE									0xFF
 #define GNMSUP1_MASTERPSEUDOADDRESS					0xFF
+#define GNMSUP1_BROADCASTADDRESS						0xFF																				// Master to every Slave (a Slave never sends with 0xFF)
+#define GNMSUP1_GROUPADDRESSBASE						0xF0																				// Multicast-Groups 0..14 use the Addresses 0xF0..0xFE
+#define GNMSUP1_GROUPCOUNT									15
+#define GNMSUP1_GROUPADDRESS(group)					(GNMSUP1_GROUPADDRESSBASE + (group))
 #define GNMSUP1_SYSTEMSERVICENUMBER					0xFF
 #define GNMSUP1_SYSTEMSERVICE_QUERYALIVE		0x00
 #define GNMSUP1_SYSTEMSERVICE_IGNORE				0x01
-#define GNMSUP1_FRAMEFLAG_DIRECTION					7
-#define GNMSUP1_FRAMEFLAG_SERVICE						6
-#define GNMSUP1_FRAMEFLAG_PUSH							5
-#define GNMSUP1_FRAMEFLAG_COMMITRECEIVE			4
-#define GNMSUP1_FRAMESTART1									0xAA
-#define GNMSUP1_FRAMESTART2									0x55
-#define GNMSUP1_FRAMESTOP1									0xCC
-#define GNMSUP1_FRAMESTOP2									0x33
-#define GNMSUP1_FRAMEBUF_FLAG								0
-#define GNMSUP1_FRAMEBUF_ADDRESS						1
-#define GNMSUP1_FRAMEBUF_PAYLOADSIZE				2
-#define GNMSUP1_FRAMEBUF_SERVICE						3
-#define GNMSUP1_FRAMEBUF_SUBSERVICE					4
-#define GNMSUP1_FRAMEBUF_PAYLOADSTART				5
-#define GNMSUP1_PUSHSTOREEMPTY							0xFF
-#define GNMSUP1_PUSHSTOREFULL								0xFF
-#define GNMSUP1_PUSHBUFFLAG_PENDING					7
+#define GNMSUP1_SYSTEMSERVICE_AGGREGATE			0x02
+#define GNMSUP1_AGGREGATE_RECORDHEADER			3																						// Record: Service, Subservice, PayloadSize, Payload
+#define GNMSUP1_SYSTEMSERVICE_SEGMENTBEGIN	0x03
+#define GNMSUP1_SYSTEMSERVICE_SEGMENTDATA		0x04
+#define GNMSUP1_SYSTEMSERVICE_SEGMENTACK		0x05
+#define GNMSUP1_SEGMENT_BEGINSIZE						6																						// Begin: Service, Subservice, SegmentSize, Length (24 Bit)
+#define GNMSUP1_SEGMENT_HEADER							2																						// Data: Sequence (16 Bit), Data
+#define GNMSUP1_SEGMENT_ACKSIZE							4																						// Ack: next missing Sequence, Bitmap of received Sequences from there (16 Bit each)
+#define GNMSUP1_SYSTEMSERVICE_REGISTERDELTA	0x06
+#define GNMSUP1_SYSTEMSERVICE_REGISTERWRITE	0x07
+#define GNMSUP1_SYSTEMSERVICE_CAPABILITIES	0x08
+#define GNMSUP1_SYSTEMSERVICE_BAUDSWITCH		0x09
+#define GNMSUP1_SYSTEMSERVICE_BAUDCOMMIT		0x0A
+#define GNMSUP1_CAPABILITIES_VERSION				0x01
+#define GNMSUP1_CAPABILITIES_SIZE						7																						// Version, Payload-Buffer, Push-Queue (16 Bit), Features, Baudrates (16 Bit)
+#define GNMSUP1_BAUDSWITCH_SIZE							6																						// Baudrate (32 Bit), Fallback-Window in ms (16 Bit)
 #define GNMSUP1_PUSHBUFFLAG_COMMITRECEIVE		6
-#define GNMSUP1_RS485_DEENABLEWAITMICROS		0
+#define GNMSUP1_PUSHBUFFLAG_QUEUED					7
+#define GNMSUP1_PUSHPRIORITIES							4																						// Priority-Classes of the Push-Queue (PushPriority)
+#define GNMSUP1_FRAMEOVERHEAD							6																						// Start-, CRC16- and Stop-Bytes around the Frame-Buffer
+#define GNMSUP1_POLLFRAMEBYTES							(GNMSUP1_FRAMEOVERHEAD + 2)											// Frame without Service: Flag and Address only
 
 
 
 // Include necessary Library's
-#include <Arduino.h>
-#include <HardwareSerial.h>
-#include <SoftwareSerial.h>
-#include <Stream.h>
+#include "gnMsup1Platform.h"
+#include "gnMsup1Transport.h"
+#include "gnMsup1Crc16.h"
+#include "gnMsup1FrameDecoder.h"
+#include "gnMsup1Timer.h"
+#include "gnMsup1Bitset.h"
+#include "gnMsup1RegisterMap.h"
+#include "gnMsup1BusManager.h"
+#include "gnMsup1Simulator.h"
 
 
 
-// Main Class
-class gnMsup1 {
+// Smallest Power of two >= value (compile-time Sizing of Tables)
+constexpr uint16_t gnMsup1Pow2Ceil(uint16_t value, uint16_t power = 1) {
+	return power >= value ? power : gnMsup1Pow2Ceil(value, power * 2);
+}
+
+
+
+// Smallest unsigned Type holding value (compile-time Counter-Widths)
+template <uint32_t value, bool fitsByte = (value <= 0xFF)> struct gnMsup1UintFor {typedef uint8_t type;};
+template <uint32_t value> struct gnMsup1UintFor<value, false> {typedef uint16_t type;};
+
+
+
+// Configuration - Limits of a Bus-Instance; the Defaults come from config.h. Derive and override single Values for an Instance:
+//                 struct BigBus : gnMsup1Config {static constexpr uint8_t maxPayloadBuffer = 64;};  gnMsup1Bus<BigBus> bus(...);
+struct gnMsup1Config {
+	static constexpr uint8_t	maxPayloadBuffer			= GNMSUP1_MAXPAYLOADBUFFER;
+	static constexpr uint16_t	maxPushQueueEntries		= GNMSUP1_MAXPUSHQEUEENTRYS;
+	static constexpr uint8_t	maxServiceCount				= GNMSUP1_MAXSERVICECOUNT;
+	static constexpr uint8_t	maxSlaveAddress				= GNMSUP1_MAXSLAVEADDRESS;
+	static constexpr uint32_t	defaultBaudrate				= GNMSUP1_DEFAULTBAUDRATE;
+	static constexpr uint16_t	frameLengthTimeout		= GNMSUP1_FRAMELENGHTTIMEOUT;
+	static constexpr uint16_t	pushTimeout						= GNMSUP1_PUSHTIMEOUT;
+	static constexpr uint32_t	pushQueueTimeout			= GNMSUP1_DEFAULTPUSHQEUETIMEOUT;
+};
+
+
+
+// Types shared by every Bus-Instance (independent of the Configuration)
+class gnMsup1Base {
 	public:
 		enum HardwareLayer	{RS485};
 		enum Role						{Slave, Master};
 		enum BlockingMode		{Synchronous, NearlyAsynchronous, FullyAsynchronous};
-		enum ComErrorCode		{None, Err_CRTimeout, Err_CRInvalid};
-				
-		// Constructor - Overloaded with Hardware- or SoftwareSerial.
-		gnMsup1(HardwareSerial& device, gnMsup1::HardwareLayer hwLayer, uint8_t rs485DePin, gnMsup1::Role role);
-		gnMsup1(SoftwareSerial& device, gnMsup1::HardwareLayer hwLayer, uint8_t rs485DePin, gnMsup1::Role role);
+		enum PushPriority		{PushLow, PushNormal, PushHigh, PushAlarm};																// Push-Queue: higher Classes are handed out first
+		enum ComErrorCode		{None, Err_CRTimeout, Err_CRInvalid, Err_TransferRejected, Err_TransferTimeout, Err_BaudrateRejected, Err_BaudrateTimeout};
+		
+		// Capabilities of a Node (see queryCapabilities); Baudrates and Features one Bit each
+		enum BaudrateMask		{Baud9600 = 0x0001, Baud19200 = 0x0002, Baud38400 = 0x0004, Baud57600 = 0x0008, Baud115200 = 0x0010, Baud230400 = 0x0020,
+												 Baud250000 = 0x0040, Baud460800 = 0x0080, Baud500000 = 0x0100, Baud921600 = 0x0200, Baud1000000 = 0x0400};
+		enum Feature				{FeaturePushAggregation = 0x01, FeatureRegisterMap = 0x02, FeatureTransferReceiver = 0x04, FeatureStatistics = 0x08};
+		struct						Capabilities {
+												uint8_t									version;
+												uint8_t									maxPayloadBuffer;
+												uint16_t								maxPushQueueEntries;
+												uint8_t									features;
+												uint16_t								baudrates;										// BaudrateMask; 0 = fixed Baudrate (no Switch)
+											};
+		static uint16_t baudrateMask(uint32_t baudRate) {
+			switch (baudRate) {
+				case 9600:		return Baud9600;
+				case 19200:		return Baud19200;
+				case 38400:		return Baud38400;
+				case 57600:		return Baud57600;
+				case 115200:	return Baud115200;
+				case 230400:	return Baud230400;
+				case 250000:	return Baud250000;
+				case 460800:	return Baud460800;
+				case 500000:	return Baud500000;
+				case 921600:	return Baud921600;
+				case 1000000:	return Baud1000000;
+				default:			return 0;
+			}
+		};
+		
+		// Service-Callbacks (see attachService)
+		typedef void (*ServiceHandlerCallback) (uint8_t subserviceNumber, const uint8_t payload[], uint8_t payloadSize, uint8_t sourceAddress);
+		typedef void (*CatchAllServiceHandlerCallback) (uint8_t serviceNumber, uint8_t subserviceNumber, const uint8_t payload[], uint8_t payloadSize, uint8_t sourceAddress);
+		struct						ServiceEntry {
+												uint8_t									serviceNumber;
+												ServiceHandlerCallback	serviceHandler;
+											};
+		static constexpr bool serviceTableSorted(const ServiceEntry table[], uint8_t count) {
+			return count < 2 || (table[0].serviceNumber < table[1].serviceNumber && serviceTableSorted(&table[1], count - 1));
+		};
+		
+		// Result- and Completion-Callbacks
+		typedef void (*CommitReceiveCallback) (uint8_t address, ComErrorCode result);
+		typedef void (*PollCompleteCallback) (uint8_t beginAddress, uint8_t endAddress);
+		typedef void (*DiscoveryCompleteCallback) (uint8_t beginAddress, uint8_t endAddress, uint8_t found);
+		typedef void (*TxCompleteCallback) (uint8_t address);
+		typedef void (*TransferSourceCallback) (uint32_t offset, uint8_t buffer[], uint8_t length);
+		typedef void (*TransferCompleteCallback) (uint8_t address, ComErrorCode result);
+		typedef void (*TransferSinkCallback) (uint32_t offset, const uint8_t data[], uint8_t length);
+		typedef void (*TransferReceivedCallback) (uint8_t serviceNumber, uint8_t subserviceNumber, uint32_t length, uint8_t sourceAddress);
+		typedef void (*RegisterCallback) (uint8_t address, uint16_t offset, const uint8_t data[], uint8_t length);
+		typedef void (*CapabilitiesCallback) (uint8_t address, const Capabilities& capabilities);
+		typedef void (*BaudrateSwitchCallback) (uint32_t baudRate, ComErrorCode result);
+		
+		// Communication-Error (see getLastComError)
+		struct						comError_t {
+												ComErrorCode						comErrorCode	= None;
+												uint8_t									address				= GNMSUP1_MASTERPSEUDOADDRESS;
+											};
+		
+		// Statistics of a Slave-Address (see statistics); Histogram-Bucket n counts Latencies below GNMSUP1_STATISTICSBUCKETMICROS << n, the last one the Rest
+		struct						Statistics {
+												uint32_t								framesSent;										// without Resends (see retries)
+												uint32_t								framesReceived;
+												uint32_t								crcFailures;									// Received Frames dropped for their Checksum
+												uint32_t								crTimeouts;
+												uint32_t								crInvalid;
+												uint32_t								retries;											// CommitReceive-Resends and Transfer-Windows resent
+												uint32_t								ignoreTransitions;						// Active -> ignored (IgnoreInactiveNodes)
+												uint32_t								pushQueueDrops;								// Push-Messages rejected (Queue full) or expired (Slave)
+												uint32_t								pushTurnaround[GNMSUP1_STATISTICSBUCKETS];	// Push-Request sent -> Answer received (Master)
+												uint32_t								crLatency[GNMSUP1_STATISTICSBUCKETS];				// Frame sent -> CRC16-Echo received
+											};
+};
+
+
+
+// Main Class - Buffers, Tables and Timeouts sized by the Configuration at compile time; gnMsup1 is the Instance with the config.h Defaults
+template <class Config = gnMsup1Config>
+class gnMsup1Bus : public gnMsup1Base {
+	public:
+		// Constructor - Overloaded with Hardware- or SoftwareSerial, or any Transport (see gnMsup1Transport.h).
+		#ifdef GNMSUP1_PLATFORM_ARDUINO
+			gnMsup1Bus(HardwareSerial& device, HardwareLayer hwLayer, uint8_t rs485DePin, Role role);
+			gnMsup1Bus(SoftwareSerial& device, HardwareLayer hwLayer, uint8_t rs485DePin, Role role);
+		#endif
+		gnMsup1Bus(gnMsup1Transport& transport, Role role);
 		
 		// Begin (for Serial, with Default-Baudrate)
 		bool begin() {return begin(_baudrate);}
@@ -101,132 +222,474 @@ class gnMsup1 {
 		// HandleCommunication - Call this Function during the loop in your Sketch; avoid long delays; Data-Processing happens in callback functions.
 		void handleCommunication();
 		
+		// NextDeadline - Milliseconds until handleCommunication() has to run again even without new Input (Frame-, CR-, Push-Timeouts,
+		//                Engines, Scavenging); 0 = now, GNMSUP1_NODEADLINE = nothing pending, only Input matters
+		//                nextDeadlineMicros: the same in Microseconds (Protocol-Timers run in Microseconds, nextDeadline rounds up)
+		uint32_t nextDeadline();
+		uint32_t nextDeadlineMicros();
+		
+		// WaitForCommunication - Sleeps until Input arrives or the next Deadline (at most maxWaitMs); true if Input arrived.
+		//                        Loop: waitForCommunication(); handleCommunication(); -> no CPU while the Bus is idle (POSIX Transports)
+		bool waitForCommunication(uint32_t maxWaitMs = GNMSUP1_NODEADLINE);
+		
 		// AttachService - Attaches a Callback Function for a Service (identified by ServiceNumber)
-		typedef void (*ServiceHandlerCallback) (uint8_t subserviceNumber, uint8_t payload[], uint8_t payloadSize, uint8_t sourceAddress);
-		typedef void (*CatchAllServiceHandlerCallback) (uint8_t serviceNumber, uint8_t subserviceNumber, uint8_t payload[], uint8_t payloadSize, uint8_t sourceAddress);
+		// The Payload is a read-only View into the Receive-Buffer; valid until the Callback returns (copy it if you need it later)
 		bool attachService(uint8_t serviceNumber, ServiceHandlerCallback serviceHandler);
+		
+		// AttachServiceTable - Attaches a compile-time Table of Services, sorted ascending by ServiceNumber; place it in PROGMEM on AVR (costs no RAM)
+		//                      Checked on attach; use static_assert(serviceTableSorted(table, count), "...") to check at compile time
+		bool attachServiceTable(const ServiceEntry table[], uint8_t count);
 		bool attachCatchAllService(CatchAllServiceHandlerCallback serviceHandler) {
 			_callbackCatchAllActive = true;
 			_callbackCatchAllHandler = serviceHandler;
+			return true;
 		};
 		
-		// Push - Sends a Frame back to Master; keep in mind to poll the messages in your master code
-		bool push(uint8_t serviceNumber, uint8_t subserviceNumber, bool commitReceivedFlag = false) {
+		// Push - Sends a Frame back to Master; keep in mind to poll the messages in your master code. A Push-Clearance gets the oldest Message
+		//        of the highest Priority; a Message not delivered within lifetimeMs (0 = Config::pushQueueTimeout) gets dropped
+		bool push(uint8_t serviceNumber, uint8_t subserviceNumber, bool commitReceivedFlag = false, PushPriority priority = PushNormal, uint32_t lifetimeMs = 0) {
 			uint8_t empty[0];
-			return push(serviceNumber, subserviceNumber, empty, 0, commitReceivedFlag);
+			return push(serviceNumber, subserviceNumber, empty, 0, commitReceivedFlag, priority, lifetimeMs);
 		}
-		bool push(uint8_t serviceNumber, uint8_t subserviceNumber, uint8_t payload[], uint8_t payloadSize, bool commitReceivedFlag = false);
-		bool pushBlockingActive() {return millis() - _pushBlockingTimer < GNMSUP1_PUSHTIMEOUT;};
-		// Send - Sends a Frame to a Slave
-		bool send(uint8_t address, uint8_t serviceNumber, uint8_t subserviceNumber, uint8_t payload[], uint8_t payloadSize, bool pushFlag = false, bool commitReceivedFlag = false, bool retryOnCrFailure = false);
+		bool push(uint8_t serviceNumber, uint8_t subserviceNumber, uint8_t payload[], uint8_t payloadSize, bool commitReceivedFlag = false, PushPriority priority = PushNormal, uint32_t lifetimeMs = 0);
+		uint16_t pushQueued() {return _pushStoreCount;};																							// Messages waiting in the Push-Queue (Slave)
+		bool pushBlockingActive() {_timer.refresh(); return _pushBlocking.running(_timer);};
+		// PushAggregation - Slave answers a Push-Clearance with as many queued Messages as fit into one Frame (Config::maxPayloadBuffer);
+		//                   the Master splits them into single Callbacks. Requires a Master of this Version.
+		void pushAggregation(bool enable) {_pushAggregation = enable;};
+		// Send - Sends a Frame to a Slave; to GNMSUP1_BROADCASTADDRESS or GNMSUP1_GROUPADDRESS(group) without CR and Push (nobody answers a Group-Frame)
+		//        With a CommitReceiveCallback, Send returns right after the Frame is out; handleCommunication collects the CR and reports its Result
+		bool send(uint8_t address, uint8_t serviceNumber, uint8_t subserviceNumber, uint8_t payload[], uint8_t payloadSize, bool pushFlag = false, bool commitReceivedFlag = false, bool retryOnCrFailure = false, CommitReceiveCallback commitReceiveHandler = nullptr);
+		bool commitReceivePending() {return _crPending;};
 		// Poll - Sends Push-Request to a Slave or a Range of Slaves
 		bool poll(uint8_t address, uint8_t maxMessagesPerSlave = 1, bool commitReceivedFlag = false, bool retryOnCrFailure = false) {
 			return pollRange(address, address, maxMessagesPerSlave, commitReceivedFlag, retryOnCrFailure);
 		};
 		bool pollRange(uint8_t beginAddress, uint8_t endAddress, uint8_t maxMessagesPerSlave = 1, bool commitReceivedFlag = false, bool retryOnCrFailure = false);
+		// StartPoll - Non-blocking Poll of a Slave or a Range of Slaves in any BlockingMode; returns at once, handleCommunication() sends one
+		//             Push-Request at a Time and moves on when answered (more Messages: same Slave again) or after Config::pushTimeout
+		bool startPoll(uint8_t beginAddress, uint8_t endAddress, uint8_t maxMessagesPerSlave = 1, bool commitReceivedFlag = false);
+		bool pollActive() {return _pollActive;};
+		void stopPoll() {_pollActive = false;};
+		void attachPollCompleteHandler(PollCompleteCallback pollCompleteHandler) {_pollCompleteHandler = pollCompleteHandler;};
+		#ifdef GNMSUP1_POLLSCHEDULER
+			// StartScheduler - Polls a Range of Slaves continuously from handleCommunication(); learns the Push-Rate per Slave and polls busy
+			//                  Slaves more often (Deficit-Round-Robin, Weight 1..maxWeight), idle ones at least every floorInterval ms
+			bool startScheduler(uint8_t beginAddress, uint8_t endAddress, uint8_t maxMessagesPerSlave = 1, bool commitReceivedFlag = false);
+			void stopScheduler() {_schedulerActive = false;};
+			bool schedulerActive() {return _schedulerActive;};
+			void schedulerFloorInterval(uint16_t floorInterval) {_schedulerFloorInterval = floorInterval;};		// Latency of idle Slaves
+			void schedulerMaxWeight(uint8_t maxWeight) {_schedulerMaxWeight = maxWeight < 1 ? 1 : maxWeight;};	// Fairness: 1 = plain Round-Robin
+			uint16_t schedulerPushRate(uint8_t address) {return address <= Config::maxSlaveAddress ? _schedulerRate[address] : 0;};	// Messages per Poll, Fixed-Point 8.8
+		#endif
+		
+		// StartTransfer - Sends a Payload larger than one Frame to a Slave in Segments, GNMSUP1_TRANSFERWINDOW at a Time; the Slave acknowledges
+		//                 every Window selectively and only the missing Segments get resent. Non-blocking, driven by handleCommunication().
+		//                 The Data is read from the Buffer (or the Source-Callback) again on a Resend, so it must stay valid until completed.
+		bool startTransfer(uint8_t address, uint8_t serviceNumber, uint8_t subserviceNumber, const uint8_t data[], uint32_t length, TransferCompleteCallback completeHandler = nullptr);
+		bool startTransfer(uint8_t address, uint8_t serviceNumber, uint8_t subserviceNumber, TransferSourceCallback source, uint32_t length, TransferCompleteCallback completeHandler = nullptr);
+		bool transferActive() {return _transferActive;};
+		void stopTransfer() {_transferActive = false;};
+		// AttachTransferReceiver (Slave) - Reassembles Transfers into a Buffer, or hands every Segment to a Sink-Callback at its Offset
+		//                                  (Segments may arrive out of Order; no Buffering in the Library). Called with the complete Transfer.
+		void attachTransferReceiver(uint8_t buffer[], uint32_t size, TransferReceivedCallback receivedHandler) {
+			_reassemblyBuffer = buffer;
+			_reassemblyBufferSize = size;
+			_reassemblySink = nullptr;
+			_reassemblyHandler = receivedHandler;
+		};
+		void attachTransferReceiver(TransferSinkCallback sink, TransferReceivedCallback receivedHandler) {
+			_reassemblyBuffer = nullptr;
+			_reassemblySink = sink;
+			_reassemblyHandler = receivedHandler;
+		};
+		
+		// Register-Map (Slave) - Mirrors a State-Table to the Master: a Push-Clearance without queued Messages pushes the dirty Spans packed
+		//                       into one Frame; Writes of the Master get applied to the Map and reported to the Callback (per Span)
+		void attachRegisterMap(gnMsup1RegisterMap& map, RegisterCallback writeHandler = nullptr, bool commitReceivedFlag = false) {
+			_registerMap = &map;
+			_registerHandler = writeHandler;
+			_registerCommitReceive = commitReceivedFlag;
+		};
+		// Register-Map (Master) - Gets the Deltas pushed by the Slaves, one Callback per Span
+		void attachRegisterDeltaHandler(RegisterCallback deltaHandler) {_registerHandler = deltaHandler;};
+		// SyncRegisters (Master) - Writes the dirty Spans of a Map (the wanted State of a Slave or Group) in as few Frames as possible
+		bool syncRegisters(uint8_t address, gnMsup1RegisterMap& map, bool commitReceivedFlag = false);
+		
+		// Capabilities - QueryCapabilities (Master) asks a Slave for its Limits, Features and Baudrates; the Answer goes to the Handler (the Call
+		//                waits for it unless FullyAsynchronous). SupportedBaudrates: Rates the Transceiver of this Node handles (Default: none)
+		bool queryCapabilities(uint8_t address);
+		void attachCapabilitiesHandler(CapabilitiesCallback capabilitiesHandler) {_capabilitiesHandler = capabilitiesHandler;};
+		void supportedBaudrates(uint16_t baudrates) {_supportedBaudrates = baudrates;};
+		uint32_t baudrate() {return _baudrate;};
+		// StartBaudrateSwitch (Master) - Moves the Bus to another Baudrate, driven by handleCommunication(): asks every Slave of the Range for its
+		//                                Baudrates, broadcasts the Switch, verifies every Slave at the new Rate and confirms them one by one. Slaves
+		//                                not confirmed within GNMSUP1_BAUDSWITCHWINDOW fall back to the old Rate, and so does the Master if one of
+		//                                them drops off. Poll, Scheduler and Transfer pause meanwhile.
+		bool startBaudrateSwitch(uint8_t beginAddress, uint8_t endAddress, uint32_t baudRate, BaudrateSwitchCallback completeHandler = nullptr);
+		bool baudrateSwitchActive() {return _baudActive;};
+		
+		// Multicast-Groups (Slave) - A Slave accepts Frames to its Address, the Broadcast-Address and the Groups it joined
+		bool joinGroup(uint8_t group);
+		bool leaveGroup(uint8_t group);
+		bool inGroup(uint8_t group) {return group < GNMSUP1_GROUPCOUNT && bitRead(_groupMask, group);};
 		
 		// BlockingMode
-		void blockingMode(gnMsup1::BlockingMode mode) {_blockingMode = mode;};
+		void blockingMode(BlockingMode mode) {_blockingMode = mode;};
+		
+		// AsyncTransmit - Frames without awaited Answer (no CommitReceive, no Push-Request) return right after queuing; DE gets released
+		//                 by handleCommunication() or txBusy() once the Transport reports TX-Complete. Keep the Loop short, DE holds the Bus.
+		void asyncTransmit(bool enable) {_txAsync = enable;};
+		bool txBusy();
+		void attachTxCompleteHandler(TxCompleteCallback txCompleteHandler) {_txCompleteHandler = txCompleteHandler;};
+		
+		// IdleGapResync - A Gap of gapMicros (e.g. 3.5 Byte-Times) ends a partial Frame at once instead of after the Frame-Timeout, and after a
+		//                 broken Frame the Bytes up to the next Gap get skipped; 0 = off (Default). Call handleCommunication() more often than the Gap.
+		void idleGapResync(uint32_t gapMicros) {_decoder.setIdleGap(gapMicros);};
 		
 		// IgnoreInactiveNodes
-		bool setIgnoreInactiveNodes(bool value) {_ignoreInactiveNodes = value;};
+		bool setIgnoreInactiveNodes(bool value) {_ignoreInactiveNodes = value; return true;};
 		bool getIgnoreInactiveNodes() {return _ignoreInactiveNodes;};
+		
+		// Discovery (Master) - Sweeps the Range with minimal Probes (Ignore-Service with CR), driven by handleCommunication() beside the other
+		//                      Engines: answering Slaves get marked active, silent ones inactive (see IgnoreInactiveNodes). Call it after begin()
+		bool startDiscovery(uint8_t beginAddress, uint8_t endAddress, DiscoveryCompleteCallback completeHandler = nullptr);
+		bool discoveryActive() {return _discoveryActive;};
+		bool nodeActive(uint8_t address) {return _activeStore.test(address);};												// Answered since begin() and not lost since
+		uint8_t activeNodes() {return _activeStore.count();};
 				
 		// GetLastComError - Provides additional Information about the Error occurred
-		struct						comError_t {
-												ComErrorCode						comErrorCode	= None;
-												uint8_t									address				= GNMSUP1_MASTERPSEUDOADDRESS;
-											};
 		comError_t getLastComError();
 		
+		// Timeouts (Master) - Push-Timeout of a Poll and CR-Timeout applied to a Slave, in Microseconds. With GNMSUP1_ADAPTIVETIMEOUTS learned from
+		//                    its Turnaround (Srtt + 4 * Deviation, at least GNMSUP1_ADAPTIVEFLOORMICROS), the fixed Timeouts otherwise and as Ceiling.
+		//                    ResetTimeouts forgets the learned Values (so does a Baudrate-Change)
+		uint32_t pushTimeoutMicros(uint8_t address) {return _pushTimeoutFor(address, GNMSUP1_POLLFRAMEBYTES);};
+		uint32_t crTimeoutMicros(uint8_t address) {return _crTimeoutFor(address);};
+		void resetTimeouts();
+		
+		// Statistics - Copies the Counters and Histograms of a Slave-Address (Master: every Slave; Slave: its own Address) while the Bus runs;
+		//              false if the Address is out of Range. Counting costs a few Instructions per Frame; ResetStatistics clears all Addresses
+		#ifdef GNMSUP1_STATISTICS
+			bool statistics(uint8_t address, Statistics& snapshot);
+			void resetStatistics() {memset(_statisticsStore, 0, sizeof(_statisticsStore));};
+		#endif
+		
 		// AttachSerialDebug - Allows to output some Debug-Informations to a Serial Port (SoftwareSerial or HardwareSerial); only works if GNMSUP1_DEBUG defined
-		void attachSerialDebug(HardwareSerial& device);
-		void attachSerialDebug(SoftwareSerial& device);
+		#ifdef GNMSUP1_PLATFORM_ARDUINO
+			void attachSerialDebug(HardwareSerial& device);
+			void attachSerialDebug(SoftwareSerial& device);
+		#endif
 		
 		
 		
 	private:
+		typedef gnMsup1Bitset<Config::maxSlaveAddress + 1> AddressSet;															// Bit per Slave-Address
+		
 		// Generic
 		bool							_initialized = false;
 		uint8_t						_address = 0;
-		gnMsup1::BlockingMode _blockingMode = GNMSUP1_DEFAULTBLOCKING;
+		BlockingMode _blockingMode = GNMSUP1_DEFAULTBLOCKING;
 		bool _ownsMasterRole() {return _address == GNMSUP1_MASTERPSEUDOADDRESS;};
+		uint16_t					_groupMask = 0;																							// Joined Multicast-Groups (Bit per Group)
+		static bool _isGroupAddress(uint8_t address) {return address >= GNMSUP1_GROUPADDRESSBASE;};
+		bool _acceptsAddress(uint8_t address) {
+			return address == _address || address == GNMSUP1_BROADCASTADDRESS ||
+						 (_isGroupAddress(address) && bitRead(_groupMask, address - GNMSUP1_GROUPADDRESSBASE));
+		};
 		
-		// Serial Hardware-Layer
-		HardwareLayer			_hwLayer;
-		HardwareSerial*		_hwStream;
-    SoftwareSerial*		_swStream;
-    Stream*						_stream;
-		uint32_t					_baudrate = GNMSUP1_DEFAULTBAUDRATE;						// Initialize with Default-Baudrate
-		
-		// RS485 Hardware-Layer
-		uint8_t						_rs485DePin;
+		// Transport-Layer
+		#ifdef GNMSUP1_PLATFORM_ARDUINO
+			gnMsup1StreamTransport	_streamTransport;														// Used by the Hardware-/SoftwareSerial Constructors
+		#endif
+		gnMsup1Transport*	_transport = nullptr;
+		uint32_t					_baudrate = Config::defaultBaudrate;						// Initialize with Default-Baudrate
 		
 		// CommError
 		comError_t				_lastComError;
 		
-		// Store for Service-Callbacks (attachService)
-		struct						_callbackStore_t {
-												uint8_t									serviceNumber;
-												ServiceHandlerCallback	serviceHandler;
-											};
-		_callbackStore_t	_callbackStore[GNMSUP1_MAXSERVICECOUNT];
-		uint8_t						_callbackStoreNextFree = 0;
-		uint8_t _getCallbackStoreNr(uint8_t serviceNumber);
+		// Service-Dispatch (attachService): Direct Table indexed by ServiceNumber, or open-addressing Hash-Table (ServiceNumber & Mask, linear Probing)
+		#ifdef GNMSUP1_DIRECTSERVICETABLE
+			ServiceHandlerCallback	_serviceTable[256] = {};
+		#else
+			static constexpr uint8_t	_serviceSlotCount = gnMsup1Pow2Ceil(Config::maxServiceCount + Config::maxServiceCount / 2 + 1);	// Load-Factor <= 2/3, at least one free Slot
+			ServiceEntry			_serviceSlots[_serviceSlotCount] = {};
+		#endif
+		uint8_t						_serviceCount = 0;
+		const ServiceEntry*	_serviceStaticTable = nullptr;															// Compile-time Table (attachServiceTable); binary Search
+		uint8_t						_serviceStaticCount = 0;
+		ServiceHandlerCallback _lookupService(uint8_t serviceNumber);
 		CatchAllServiceHandlerCallback	_callbackCatchAllHandler;
 		bool							_callbackCatchAllActive = false;
 		
-		// Frame Handling
-		#if GNMSUP1_MAXPAYLOADBUFFER < (256 - 10)													// Adjust Type of BufferCounter to Buffer-Size (and Header).
-			uint8_t						_framePosition = 0;
-		#else
-			uint16_t					_framePosition = 0;
-		#endif
-		uint8_t						_frameBuffer[GNMSUP1_FRAMEBUF_PAYLOADSTART + GNMSUP1_MAXPAYLOADBUFFER];
-		uint16_t					_frameChecksum;
-		uint32_t					_frameStartTime;
-		uint16_t					_frameTimeout;
+		// Frame Handling; two Receive-Buffers, so a Callback can receive (send and wait) while its own Frame stays untouched
+		uint8_t						_rxBuffer[2][GNMSUP1_FRAMEBUF_PAYLOADSTART + Config::maxPayloadBuffer];
+		uint8_t						_rxBufferBusy = 0;																					// Bit per Receive-Buffer, set while its Frame is processed
+		uint8_t*					_rxFrame = nullptr;																				// Frame in Validation/Processing
+		uint8_t						_txBuffer[GNMSUP1_FRAMEBUF_PAYLOADSTART + Config::maxPayloadBuffer];
+		gnMsup1FrameDecoder	_decoder = gnMsup1FrameDecoder(_rxBuffer[0], Config::maxPayloadBuffer);
+		uint8_t						_rxChunk[GNMSUP1_RXCHUNKSIZE];														// Bytes read from the Transport but not yet fed to the Decoder
+		uint8_t						_rxChunkPosition = 0;
+		uint8_t						_rxChunkLength = 0;
+		bool _rxPending() {return _rxChunkPosition < _rxChunkLength || _transport->available();};
+		uint16_t					_txChecksum;
+		bool							_txAsync = false;
+		bool							_txBusy = false;																						// DE set, Frame still on the Line
+		bool							_txCompletePending = false;																// Completion not yet reported (Callback runs from handleCommunication or before the next Frame)
+		uint8_t						_txAddress = GNMSUP1_MASTERPSEUDOADDRESS;									// Destination of the last Frame
+		TxCompleteCallback	_txCompleteHandler = nullptr;
+		void _txStart(uint8_t address, bool wait);
+		void _txService(bool wait);
+		void _txReport();
+		uint16_t					_txLength = 0;																							// Bytes of the Frame in the Transmit-Buffer (kept for a Resend)
+		void _txWriteFrame();
+		
+		// Pending CommitReceive; the Frame stays in the Transmit-Buffer until the CRC16-Echo is checked
+		bool							_crPending = false;
+		uint8_t						_crAddress = 0;
+		bool							_crRetry = false;
+		uint8_t						_crBuffer[2];
+		uint8_t						_crReceived = 0;
+		gnMsup1Deadline		_crDeadline;																								// CRC16-Echo due (40% of the Frame-Timeout); its Start is the CR-Latency Reference
+		ComErrorCode	_crResult = None;
+		CommitReceiveCallback	_crHandler = nullptr;
+		void _crStart(uint8_t address, bool retry, CommitReceiveCallback handler);
+		void _crService();
+		uint32_t					_frameStartTime;																						// micros() at StartByte 2 of the Frame in Processing
+		uint32_t					_frameTimeout;																							// Microseconds
+		static constexpr uint32_t _frameTimeoutFor(uint32_t baudRate) {																// Frame-Length * Factor * Time/Byte [Microseconds]
+			return (uint32_t)(10 + Config::maxPayloadBuffer) * Config::frameLengthTimeout * (10000000ul / baudRate);
+		};
+		static constexpr uint32_t _defaultFrameTimeout = _frameTimeoutFor(Config::defaultBaudrate);							// No Division at Runtime for the Default-Baudrate
+		static constexpr uint32_t _pushTimeoutMicros = (uint32_t)Config::pushTimeout * 1000;
+		gnMsup1Timer			_timer;																											// Timestamp of the current Pass (see gnMsup1Timer.h)
 		bool 							_additionalPushMsgAvailable = false;
+		void _handleCommunication(bool runEngines);
+		static void _deadlineUpdate(uint32_t& deadline, uint32_t remaining) {													// Keeps the earliest Deadline
+			if (remaining < deadline) {
+				deadline = remaining;
+			}
+		};
 		bool _readInput();
 		void _processFrame();
-		void _resetAndStartFrame(uint8_t inputBuffer);
-		void _resetFramebuffer();
 		bool _validateFrame();
-		bool _handleSystemService(bool pushFlag);
+		bool _handleSystemService(const uint8_t frame[], bool pushFlag);
+		void _dispatchService(uint8_t serviceNumber, uint8_t subserviceNumber, const uint8_t payload[], uint8_t payloadSize, uint8_t sourceAddress);
 		
-		// Store for Push-Requests
+		// Store for Push-Requests: a FIFO per Priority-Class, linked through the Slots; every Entry expires at its own Deadline
+		typedef typename gnMsup1UintFor<Config::maxPushQueueEntries>::type PushIndex;										// 8 Bit unless the Queue holds more than 255 Entries
 		struct						_pushStore_t {
 												uint8_t									flags;
-												uint32_t								timestamp;
+												uint8_t									priority;
+												PushIndex								next;													// Next Entry of the Class (or next free Slot)
+												uint16_t								ticket;												// Identifies the Entry while queued
+												uint32_t								expiry;												// millis() of the Deadline
 												uint8_t									serviceNumber;
 												uint8_t									subserviceNumber;
 												uint8_t									payloadSize;
-												uint8_t									payload[GNMSUP1_MAXPAYLOADBUFFER];
+												uint8_t									payload[Config::maxPayloadBuffer];
 											};
-		_pushStore_t			_pushStore[GNMSUP1_MAXPUSHQEUEENTRYS];
-		uint32_t 					_pushBlockingTimer = millis() - GNMSUP1_PUSHTIMEOUT - 1;
-		void _pushBlockingSet() {_pushBlockingTimer = millis();};
-		void _pushBlockingRelease() {_pushBlockingTimer = millis() - GNMSUP1_PUSHTIMEOUT - 1;};
+		_pushStore_t			_pushStore[Config::maxPushQueueEntries];
+		PushIndex					_pushClassHead[GNMSUP1_PUSHPRIORITIES] = {};												// Oldest Entry per Class
+		PushIndex					_pushClassTail[GNMSUP1_PUSHPRIORITIES] = {};
+		PushIndex					_pushClassCount[GNMSUP1_PUSHPRIORITIES] = {};
+		PushIndex					_pushStoreCount = 0;
+		PushIndex					_pushStoreFresh = 0;																		// Slots from here on never used
+		PushIndex					_pushFreeHead = 0;																			// Released Slots, linked
+		PushIndex					_pushFreeCount = 0;
+		uint16_t					_pushStoreTickets = 0;
+		uint32_t					_pushStoreExpiry = 0;																		// No Entry expires before (Sweep due)
+		gnMsup1Deadline		_pushBlocking;																							// Armed while a Push-Answer is outstanding (Master)
+		void _pushBlockingSet(uint8_t address, uint16_t frameBytes);
+		void _pushBlockingRelease() {
+			_pushBlocking.disarm();
+			#ifdef GNMSUP1_ADAPTIVETIMEOUTS
+				_adaptivePushOpen = false;
+			#endif
+		};
 		void _pushBlockingWaitForRelease();
-		uint8_t	_pushStoreNextToSend();
-		uint8_t	_pushStoreNextFree();
+		bool							_pushAggregation = false;
+		_pushStore_t* _pushStoreFront();
+		_pushStore_t* _pushStoreEnqueue(uint8_t priority, uint32_t lifetimeMs);
+		void _pushStoreRemove(PushIndex slot);
+		void _pushStoreRemove(PushIndex slot, PushIndex previous);
+		void _pushStoreExpire();
+		bool _pushStoreQueued(PushIndex slot, uint16_t ticket) {
+			return bitRead(_pushStore[slot].flags, GNMSUP1_PUSHBUFFLAG_QUEUED) && _pushStore[slot].ticket == ticket;
+		};
+		
+		// Poll-Engine (startPoll)
+		bool							_pollActive = false;
+		bool							_pollAwaiting = false;																				// Push-Request sent, Answer or Timeout outstanding
+		bool							_pollCommitReceive = false;
+		uint8_t						_pollBeginAddress = 0;
+		uint8_t						_pollEndAddress = 0;
+		uint8_t						_pollAddress = 0;
+		uint8_t						_pollMaxMessages = 1;
+		uint8_t						_pollRemainingMessages = 1;
+		PollCompleteCallback	_pollCompleteHandler = nullptr;
+		uint8_t						_pollMessages = 0;																					// Messages received for the current Slave
+		void _pollService();
+		
+		// Poll-Scheduler (startScheduler): Push-Rate (EWMA), Deficit and last Poll per Slave
+		#ifdef GNMSUP1_POLLSCHEDULER
+			bool							_schedulerActive = false;
+			uint8_t						_schedulerBeginAddress = 0;
+			uint8_t						_schedulerEndAddress = 0;
+			uint8_t						_schedulerAddress = 0;																			// Last scheduled Slave
+			uint8_t						_schedulerMaxMessages = 1;
+			bool							_schedulerCommitReceive = false;
+			uint16_t					_schedulerFloorInterval = GNMSUP1_SCHEDULERFLOORINTERVAL;
+			uint8_t						_schedulerMaxWeight = GNMSUP1_SCHEDULERMAXWEIGHT;
+			uint16_t					_schedulerRate[(Config::maxSlaveAddress + 1)];
+			uint16_t					_schedulerDeficit[(Config::maxSlaveAddress + 1)];												// Up to 2 * maxWeight
+			uint32_t					_schedulerLastPoll[(Config::maxSlaveAddress + 1)];
+			void _schedulerService();
+			void _schedulerUpdate(uint8_t address, uint8_t messages, bool backlog);
+		#endif
+		
+		// Register-Map
+		gnMsup1RegisterMap*	_registerMap = nullptr;
+		RegisterCallback	_registerHandler = nullptr;
+		bool							_registerCommitReceive = false;
+		bool _registerPending() {return _registerMap && _registerMap->dirty();};
+		void _registerDispatch(const uint8_t frame[]);
+		
+		// Segmented Transfer, Master (startTransfer): Window-Base and Bitmap of the acknowledged Segments from there
+		static constexpr uint8_t _segmentSize = Config::maxPayloadBuffer - GNMSUP1_SEGMENT_HEADER;
+		bool							_transferActive = false;
+		bool							_transferOpened = false;																				// Begin acknowledged by the Slave
+		bool							_transferAwaiting = false;																			// Window sent, Ack or Timeout outstanding
+		bool							_transferAcknowledged = false;
+		bool							_transferRejected = false;
+		uint8_t						_transferAddress = 0;
+		uint8_t						_transferServiceNumber = 0;
+		uint8_t						_transferSubserviceNumber = 0;
+		uint8_t						_transferRetries = 0;
+		uint32_t					_transferLength = 0;
+		uint16_t					_transferSegments = 0;
+		uint16_t					_transferNext = 0;																						// First Segment not yet received by the Slave
+		uint16_t					_transferAcked = 0;																						// Bit n: Segment (_transferNext + n) received
+		const uint8_t*		_transferData = nullptr;
+		TransferSourceCallback	_transferSource = nullptr;
+		TransferCompleteCallback	_transferCompleteHandler = nullptr;
+		bool _transferStart(uint8_t address, uint8_t serviceNumber, uint8_t subserviceNumber, uint32_t length, TransferCompleteCallback completeHandler);
+		void _transferService();
+		void _transferAcknowledge(const uint8_t frame[]);
+		
+		// Segmented Transfer, Slave (attachTransferReceiver): next missing Segment and Bitmap of the received ones from there
+		uint8_t*					_reassemblyBuffer = nullptr;
+		uint32_t					_reassemblyBufferSize = 0;
+		TransferSinkCallback	_reassemblySink = nullptr;
+		TransferReceivedCallback	_reassemblyHandler = nullptr;
+		bool							_reassemblyActive = false;
+		uint8_t						_reassemblyServiceNumber = 0;
+		uint8_t						_reassemblySubserviceNumber = 0;
+		uint8_t						_reassemblySegmentSize = 0;
+		uint32_t					_reassemblyLength = 0;
+		uint16_t					_reassemblySegments = 0;
+		uint16_t					_reassemblyNext = 0;
+		uint16_t					_reassemblyReceived = 0;																			// Bit n: Segment (_reassemblyNext + n) received
+		bool _reassemblyBegin(const uint8_t frame[]);
+		void _reassemblySegment(const uint8_t frame[]);
+		void _reassemblyAcknowledge(bool accepted, bool additionalPushMessagesFlag);
+		
+		// Capabilities and Baudrate-Switch: Master runs the Switch-Engine (Query, Switch, Verify, Commit, Fallback), a switched Slave
+		// waits for its Commit until the Window passed
+		enum							_baudState_t {_BaudQuery, _BaudVerify, _BaudCommit, _BaudFallback};
+		uint16_t					_supportedBaudrates = 0;
+		CapabilitiesCallback	_capabilitiesHandler = nullptr;
+		bool							_baudActive = false;
+		bool							_baudAwaiting = false;																					// Request sent, Answer or Timeout outstanding
+		bool							_baudAnswered = false;
+		bool							_baudCapable = false;																						// Capabilities of the queried Slave include the new Rate
+		_baudState_t			_baudState = _BaudQuery;
+		uint8_t						_baudBeginAddress = 0;
+		uint8_t						_baudEndAddress = 0;
+		uint8_t						_baudAddress = 0;
+		uint8_t						_baudRetries = 0;
+		AddressSet				_baudPresent;																								// Slaves that answered the Query
+		uint32_t					_baudTarget = 0;
+		uint32_t					_baudFallbackRate = 0;
+		bool							_baudFallbackPending = false;																		// Slave: switched, Commit outstanding
+		gnMsup1Deadline		_baudWindow;																								// Fallback-Window
+		gnMsup1Deadline		_baudSettle;																								// Master: Pause before talking at the new (or old) Rate
+		BaudrateSwitchCallback	_baudCompleteHandler = nullptr;
+		bool _setBaudrate(uint32_t baudRate);
+		void _baudService();
+		void _baudNext(uint8_t first);
+		void _baudFallback();
+		void _baudComplete(ComErrorCode result, uint8_t address);
+		void _capabilitiesAnswer(bool additionalPushMessagesFlag, bool commitReceivedFlag);
+		void _capabilitiesReceive(const uint8_t frame[]);
+		void _baudSwitchReceive(const uint8_t frame[]);
 		
 		// SendFrame -> Internal Send Function
-		bool _sendFrame(uint8_t address, uint8_t serviceNumber, uint8_t subserviceNumber, bool serviceFlag, bool pushFlag, bool waitForPushAnswer, bool commitReceivedFlag, bool retryOnCrFailure, uint8_t payload[], uint8_t payloadSize);
+		bool _sendFrame(uint8_t address, uint8_t serviceNumber, uint8_t subserviceNumber, bool serviceFlag, bool pushFlag, bool waitForPushAnswer, bool commitReceivedFlag, bool retryOnCrFailure, uint8_t payload[], uint8_t payloadSize, CommitReceiveCallback commitReceiveHandler = nullptr);
 				
 		// Active/Ignore Functions
 		bool							_ignoreInactiveNodes = false;
-		uint8_t 					_ignoreStore[(GNMSUP1_MAXSLAVEADDRESS + 1)];	// Set bit for Slaves with no activity; They will be ignored.
-		uint8_t 					_activeStore[(GNMSUP1_MAXSLAVEADDRESS + 1)];	// Set bit for active Slaves; They wont be rescanned
+		AddressSet				_ignoreStore;																								// Slaves with no activity; They will be ignored.
+		AddressSet				_activeStore;																								// Slaves that answered
+		AddressSet				_lostStore;																									// Active once, then ignored: the Scavenging probes them first
+		AddressSet				_scavengingRound;																						// Ignored Slaves not probed yet in this Interval
 		uint32_t					_scavengingInactiveLastTimestamp = 0;
-		uint8_t						_scavengingInactiveNextAddress = 0;
+		uint8_t						_scavengingInactiveNextAddress = 0;																// Round-Robin Cursor of the Scavenging
+		uint8_t						_scavengingBudget = 0;																			// Failed Probes left in this Interval
 		bool _queryIgnore(uint8_t address);
 		bool _queryActive(uint8_t address);
 		void _markActive(uint8_t address);
 		void _markIgnore(uint8_t address);
-		void _resetActiveIgnore(uint8_t address);
 		void _scavengingInactive();
 		
+		// Probes of Discovery and Scavenging: one at a Time, its CRC16-Echo collected by handleCommunication (no Wait)
+		AddressSet				_probePending;																							// Discovery: Addresses left to probe
+		bool							_probeAwaiting = false;
+		bool							_probeScavenging = false;																		// The outstanding Probe counts against the Budget
+		uint8_t						_probeAddress = 0;
+		comError_t				_probeComError;																							// Probes report no Errors: ErrorStore before the Probe
+		bool							_discoveryActive = false;
+		uint8_t						_discoveryBeginAddress = 0;
+		uint8_t						_discoveryEndAddress = 0;
+		uint8_t						_discoveryFound = 0;
+		DiscoveryCompleteCallback	_discoveryCompleteHandler = nullptr;
+		void _probeService();
+		void _probeSend(uint8_t address, bool scavenging);
+		void _probeResult(ComErrorCode result);
+		static void _probeNoWait(uint8_t, ComErrorCode) {};																// CR-Handler of the Probes: _sendFrame returns without waiting
+		
+		// Adaptive Timeouts per Slave-Address (Master); without GNMSUP1_ADAPTIVETIMEOUTS the Helpers return the fixed Timeouts and learn nothing
+		#ifdef GNMSUP1_ADAPTIVETIMEOUTS
+			struct						_adaptive_t {
+													gnMsup1RttEstimator			push;												// Push-Request on the Line -> Answer starts
+													gnMsup1RttEstimator			cr;													// Last Stop-Bit of the Frame -> CRC16-Echo starts
+													gnMsup1RttEstimator			frame;											// Gaps within the Frames of the Slave
+												};
+			_adaptive_t				_adaptiveStore[(Config::maxSlaveAddress + 1)];
+			uint8_t						_adaptivePushAddress = GNMSUP1_BROADCASTADDRESS;										// Last Push-Request: Slave and Frame-Size
+			uint16_t					_adaptivePushBytes = 0;
+			bool							_adaptivePushOpen = false;																	// Not answered yet; still open at the next Request = Timeout
+		#endif
+		uint32_t					_byteTime16 = 0;																						// Time of a Byte on the Line in 1/16 Microseconds (also for the Probes)
+		uint32_t _airtime(uint16_t bytes) {return ((uint32_t)bytes * _byteTime16) >> 4;};
+		uint32_t _pushTimeoutFor(uint8_t address, uint16_t frameBytes);
+		uint32_t _crTimeoutFor(uint8_t address);
+		uint32_t _rxFrameTimeout();
+		void _adaptiveBaudrate(uint32_t baudRate);
+		void _adaptivePushAnswer(uint8_t address, uint32_t startMicros);
+		void _adaptiveCr(ComErrorCode result);
+		void _adaptiveFrame(const uint8_t frame[], uint32_t startMicros);
+		void _adaptiveFrameDrop();
+		
+		// Statistics per Slave-Address; the Helpers compile to nothing without GNMSUP1_STATISTICS
+		#ifdef GNMSUP1_STATISTICS
+			Statistics				_statisticsStore[(Config::maxSlaveAddress + 1)] = {};
+			uint8_t						_statisticsPushAddress = 0;																	// Push-Request on the Line: Address and Start of the Turnaround
+			uint32_t					_statisticsPushMicros = 0;
+		#endif
+		void _statisticsCount(uint8_t address, uint32_t Statistics::* counter);
+		void _statisticsLatency(uint8_t address, uint32_t (Statistics::* histogram)[GNMSUP1_STATISTICSBUCKETS], uint32_t startMicros);
+		
 		// Debugging
 		#ifdef GNMSUP1_DEBUG
 			HardwareSerial*		_hwDebugStream;
@@ -236,4 +699,14 @@ class gnMsup1 {
 			void _debugPrintHex(uint8_t value);
 		#endif
 };
+
+
+
+// Bus-Instance with the config.h Defaults
+typedef gnMsup1Bus<> gnMsup1;
+
+
+
+// Implementation (Templates)
+#include "gnMsup1Impl.h"
 #endif	// #ifndef gnMsup1_h
\ No newline at end of file
@@ -0,0 +1,138 @@
+/*  GN Master Slave Universal Protocol Library
+ *  ==========================================
+ *
+ *  Library for generic Master/Slave Communications.
+ *
+ *  Bitset: fixed Set of Bits (one per Slave-Address) in Words of the native Width. Scans skip empty Words at once and
+ *  find the next Member by Count-Trailing-Zeros, Set-Operations run Word by Word.
+ *
+ *	MIT License
+ *
+ *	Copyright (c) 2018 Andreas Gloor
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+
+
+ // Assure the Library gets loaded not more than once
+#ifndef gnMsup1Bitset_h
+#define gnMsup1Bitset_h
+
+
+
+// Include necessary Library's
+#include "gnMsup1Platform.h"
+
+
+
+// Bitset - Bits 0..Bits-1; Members beyond Bits never get set
+template <uint16_t Bits>
+class gnMsup1Bitset {
+	public:
+		#ifdef __AVR__
+			typedef uint8_t		Word;																											// Native Width: no Multi-Byte Shifts on AVR
+		#else
+			typedef uint32_t	Word;
+		#endif
+		static constexpr uint16_t	bits = Bits;
+		static constexpr uint8_t	wordBits = sizeof(Word) * 8;
+		static constexpr uint16_t	words = (Bits + wordBits - 1) / wordBits;
+		
+		bool test(uint16_t bit) const {return bit < Bits && ((_words[bit / wordBits] >> (bit % wordBits)) & 1);};
+		void set(uint16_t bit) {
+			if (bit < Bits) {
+				_words[bit / wordBits] |= (Word)1 << (bit % wordBits);
+			}
+		};
+		void clear(uint16_t bit) {
+			if (bit < Bits) {
+				_words[bit / wordBits] &= ~((Word)1 << (bit % wordBits));
+			}
+		};
+		void reset() {
+			for (uint16_t i = 0; i < words; i++) {
+				_words[i] = 0;
+			}
+		};
+		
+		// SetRange - Sets first..last (inclusive), whole Words at once
+		void setRange(uint16_t first, uint16_t last) {
+			if (last >= Bits) {
+				last = Bits - 1;
+			}
+			while (first <= last && first < Bits) {
+				uint8_t offset = first % wordBits;
+				uint16_t span = last - first + 1;
+				if (offset == 0 && span >= wordBits) {
+					_words[first / wordBits] = (Word)~(Word)0;
+					first += wordBits;
+				} else {
+					set(first++);
+				}
+			}
+		};
+		
+		// Set-Operations, Word by Word
+		void merge(const gnMsup1Bitset& other) {
+			for (uint16_t i = 0; i < words; i++) {
+				_words[i] |= other._words[i];
+			}
+		};
+		void intersect(const gnMsup1Bitset& other) {
+			for (uint16_t i = 0; i < words; i++) {
+				_words[i] &= other._words[i];
+			}
+		};
+		bool any() const {
+			for (uint16_t i = 0; i < words; i++) {
+				if (_words[i]) {
+					return true;
+				}
+			}
+			return false;
+		};
+		uint16_t count() const {
+			uint16_t count = 0;
+			for (uint16_t i = 0; i < words; i++) {
+				count += __builtin_popcountl(_words[i]);
+			}
+			return count;
+		};
+		
+		// Find - First Member at or after from; bits if none (call find(0) to wrap around)
+		uint16_t find(uint16_t from) const {
+			if (from >= Bits) {
+				return Bits;
+			}
+			uint16_t index = from / wordBits;
+			Word word = _words[index] & (Word)((Word)~(Word)0 << (from % wordBits));						// Drop the Members below from
+			while (!word) {
+				if (++index == words) {
+					return Bits;
+				}
+				word = _words[index];
+			}
+			return index * wordBits + __builtin_ctzl(word);
+		};
+	
+	private:
+		Word							_words[words] = {};
+};
+#endif	// #ifndef gnMsup1Bitset_h
@@ -0,0 +1,270 @@
+/*  GN Master Slave Universal Protocol Library
+ *  ==========================================
+ *
+ *  Library for generic Master/Slave Communications.
+ *
+ *  Bus-Manager (see gnMsup1BusManager.h).
+ *
+ *	MIT License
+ *
+ *	Copyright (c) 2018 Andreas Gloor
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+
+
+// Include necessary Library's
+#include "gnMsup1BusManager.h"
+
+#ifdef GNMSUP1_PLATFORM_POSIX
+#include <fcntl.h>
+#include <limits.h>
+
+
+
+thread_local int gnMsup1BusManager::_currentBus = -1;
+
+
+
+// Destructor -> Stop the Threads and close the Wake-Pipes
+gnMsup1BusManager::~gnMsup1BusManager() {
+	stop();
+	for (uint8_t i = 0; i < _busCount; i++) {
+		close(_buses[i].wake[0]);
+		close(_buses[i].wake[1]);
+		pthread_mutex_destroy(&_buses[i].taskMutex);
+	}
+}
+
+
+
+// Attach -> Adds a Bus (type-erased by its Step-Function)
+int gnMsup1BusManager::_attach(void* bus, StepFunction step, gnMsup1PosixTransport* transport) {
+	if (_running || _busCount >= GNMSUP1_BUSMANAGER_MAXBUSES) {
+		return -1;
+	}
+	
+	_bus_t& entry = _buses[_busCount];
+	if (pipe(entry.wake) != 0) {
+		return -1;
+	}
+	fcntl(entry.wake[0], F_SETFL, O_NONBLOCK);
+	fcntl(entry.wake[1], F_SETFL, O_NONBLOCK);
+	pthread_mutex_init(&entry.taskMutex, nullptr);
+	entry.manager = this;
+	entry.index = _busCount;
+	entry.bus = bus;
+	entry.step = step;
+	entry.transport = transport;
+	entry.taskHead = 0;
+	entry.taskCount = 0;
+	entry.deadline = 0;																																				// Serve once before the first Sleep
+	entry.deadlineTimestamp = millis();
+	entry.hangup = false;
+	return _busCount++;
+}
+
+
+
+// Start -> One Thread per Bus
+bool gnMsup1BusManager::start() {
+	if (_running.exchange(true)) {
+		return false;
+	}
+	if (_polling) {																																						// A Thread serves the Buses in poll()
+		_running = false;
+		return false;
+	}
+	
+	for (uint8_t i = 0; i < _busCount; i++) {
+		if (pthread_create(&_buses[i].thread, nullptr, _run, &_buses[i]) != 0) {
+			_running = false;																																			// Unwind the Threads started so far
+			for (uint8_t j = 0; j < i; j++) {
+				write(_buses[j].wake[1], "", 1);
+				pthread_join(_buses[j].thread, nullptr);
+			}
+			return false;
+		}
+	}
+	return true;
+}
+
+
+
+// Stop -> Wake every Thread and join it
+void gnMsup1BusManager::stop() {
+	if (!_running) {
+		return;
+	}
+	
+	_running = false;
+	for (uint8_t i = 0; i < _busCount; i++) {
+		write(_buses[i].wake[1], "", 1);
+	}
+	for (uint8_t i = 0; i < _busCount; i++) {
+		pthread_join(_buses[i].thread, nullptr);
+	}
+}
+
+
+
+// Poll -> Serves every Bus once from the calling Thread, after waiting for Input, a Task or the earliest Deadline
+bool gnMsup1BusManager::poll(int timeoutMs) {
+	if (_polling.exchange(true)) {
+		return false;
+	}
+	if (_running) {																																						// The Bus-Threads serve the Buses
+		_polling = false;
+		return false;
+	}
+	
+	struct pollfd fds[2 * GNMSUP1_BUSMANAGER_MAXBUSES];
+	for (uint8_t i = 0; i < _busCount; i++) {
+		int timeout = _watch(_buses[i], fds[2 * i], _pollTimeout(_remaining(_buses[i])));
+		if (timeout >= 0 && (timeoutMs < 0 || timeout < timeoutMs)) {
+			timeoutMs = timeout;
+		}
+		fds[2 * i + 1].fd = _buses[i].wake[0];
+		fds[2 * i + 1].events = POLLIN;
+	}
+	::poll(fds, 2 * _busCount, timeoutMs);
+	
+	for (uint8_t i = 0; i < _busCount; i++) {
+		_checkHangup(_buses[i], fds[2 * i]);
+		_currentBus = i;
+		_serve(_buses[i]);
+	}
+	_currentBus = -1;
+	_polling = false;
+	return true;
+}
+
+
+
+// Post -> Queues a Task for the Thread of the Bus and wakes it
+bool gnMsup1BusManager::post(uint8_t bus, gnMsup1BusManager::Task task, void* context) {
+	if (bus >= _busCount) {
+		return false;
+	}
+	
+	_bus_t& entry = _buses[bus];
+	pthread_mutex_lock(&entry.taskMutex);
+	bool queued = entry.taskCount < GNMSUP1_BUSMANAGER_TASKQUEUE;
+	if (queued) {
+		uint8_t slot = (entry.taskHead + entry.taskCount) % GNMSUP1_BUSMANAGER_TASKQUEUE;
+		entry.tasks[slot] = task;
+		entry.contexts[slot] = context;
+		entry.taskCount++;
+	}
+	pthread_mutex_unlock(&entry.taskMutex);
+	
+	if (queued) {
+		write(entry.wake[1], "", 1);
+	}
+	return queued;
+}
+
+
+
+// Run -> Thread of a Bus: serve it, sleep in poll() on the Serial-Port and the Wake-Pipe until its next Deadline
+void* gnMsup1BusManager::_run(void* bus) {
+	_bus_t& entry = *static_cast<_bus_t*>(bus);
+	_currentBus = entry.index;
+	
+	struct pollfd fds[2];
+	fds[1].fd = entry.wake[0];
+	fds[1].events = POLLIN;
+	while (entry.manager->_running) {
+		_serve(entry);
+		if (entry.deadline > 0) {
+			::poll(fds, 2, _watch(entry, fds[0], _pollTimeout(entry.deadline)));
+			_checkHangup(entry, fds[0]);
+		}
+	}
+	return nullptr;
+}
+
+
+
+// Serve -> Runs the posted Tasks, then one handleCommunication(); keeps the next Deadline of the Bus
+void gnMsup1BusManager::_serve(_bus_t& bus) {
+	uint8_t drain[16];
+	while (read(bus.wake[0], drain, sizeof(drain)) > 0) {}
+	
+	while (true) {
+		pthread_mutex_lock(&bus.taskMutex);
+		if (bus.taskCount == 0) {
+			pthread_mutex_unlock(&bus.taskMutex);
+			break;
+		}
+		Task task = bus.tasks[bus.taskHead];
+		void* context = bus.contexts[bus.taskHead];
+		bus.taskHead = (bus.taskHead + 1) % GNMSUP1_BUSMANAGER_TASKQUEUE;
+		bus.taskCount--;
+		pthread_mutex_unlock(&bus.taskMutex);
+		task(context);																																					// Outside the Lock: the Task may post again
+	}
+	
+	bus.deadline = bus.step(bus.bus);
+	bus.deadlineTimestamp = millis();
+}
+
+
+
+// Remaining -> Time left to the Deadline taken after the last Step
+uint32_t gnMsup1BusManager::_remaining(_bus_t& bus) {
+	if (bus.deadline == GNMSUP1_NODEADLINE) {
+		return GNMSUP1_NODEADLINE;
+	}
+	uint32_t elapsed = millis() - bus.deadlineTimestamp;
+	return elapsed < bus.deadline ? bus.deadline - elapsed : 0;
+}
+
+
+
+// PollTimeout -> Deadline as poll() Timeout (-1 waits for Input only)
+int gnMsup1BusManager::_pollTimeout(uint32_t deadline) {
+	if (deadline == GNMSUP1_NODEADLINE) {
+		return -1;
+	}
+	return deadline > INT_MAX ? INT_MAX : (int)deadline;
+}
+
+
+
+// Watch -> The Port of the Bus as poll() Entry; a hung-up Port (e.g. Pty without Peer) sits out one Round, which lasts
+//          GNMSUP1_POSIX_HANGUPRETRY at most, instead of waking poll() at once
+int gnMsup1BusManager::_watch(_bus_t& bus, struct pollfd& descriptor, int timeout) {
+	descriptor.fd = bus.hangup ? -1 : bus.transport->fd();
+	descriptor.events = POLLIN;
+	descriptor.revents = 0;
+	if (bus.hangup && (timeout < 0 || timeout > GNMSUP1_POSIX_HANGUPRETRY)) {
+		timeout = GNMSUP1_POSIX_HANGUPRETRY;
+	}
+	return timeout;
+}
+
+
+
+// CheckHangup -> Notes a Hang-up or Error without Input, so the next Round leaves the Port out
+void gnMsup1BusManager::_checkHangup(_bus_t& bus, const struct pollfd& descriptor) {
+	bus.hangup = descriptor.fd >= 0 && (descriptor.revents & (POLLHUP | POLLERR | POLLNVAL)) && !(descriptor.revents & POLLIN);
+}
+#endif	// #ifdef GNMSUP1_PLATFORM_POSIX
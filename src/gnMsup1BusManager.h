@@ -0,0 +1,132 @@
+/*  GN Master Slave Universal Protocol Library
+ *  ==========================================
+ *
+ *  Library for generic Master/Slave Communications.
+ *
+ *  Bus-Manager (POSIX Host): runs several Buses (RS485 Segments) side by side, each one confined to its own Thread, or
+ *  all of them in one poll() Loop. A Bus waits in poll() on its Serial-Port instead of spinning; other Threads hand
+ *  Work to a Bus by post(), so a Bus-Instance is never touched by two Threads.
+ *
+ *	MIT License
+ *
+ *	Copyright (c) 2018 Andreas Gloor
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+
+
+ // Assure the Library gets loaded not more than once
+#ifndef gnMsup1BusManager_h
+#define gnMsup1BusManager_h
+
+
+
+// Include Config File -> Please just change Values in Config File, not here
+#include "config.h"
+
+
+
+// Include necessary Library's
+#include "gnMsup1Platform.h"
+#include "gnMsup1Transport.h"
+
+#ifdef GNMSUP1_PLATFORM_POSIX
+#include <atomic>
+#include <poll.h>
+#include <pthread.h>
+
+
+
+// Bus-Manager
+class gnMsup1BusManager {
+	public:
+		typedef void (*Task) (void* context);
+
+		gnMsup1BusManager() {};
+		~gnMsup1BusManager();
+
+		// Attach - Adds a Bus (any gnMsup1Bus, begin() called) with its Transport; returns the Bus-Index, -1 if full (GNMSUP1_BUSMANAGER_MAXBUSES)
+		template <class Bus> int attach(Bus& bus, gnMsup1PosixTransport& transport) {
+			return _attach(&bus, &_step<Bus>, &transport);
+		}
+
+		// Start - One Thread per Bus, each calls handleCommunication() and sleeps in poll() until Input, a posted Task or the
+		//         nextDeadline() of its Bus; Stop joins them
+		bool start();
+		void stop();
+		bool running() {return _running;};
+
+		// Poll - Alternative to start(): serves every Bus once from the calling Thread, after waiting up to timeoutMs for Input, a Task
+		//        or the earliest Deadline (-1: no Limit); false while the Threads run or another Thread is in poll().
+		//        Blocking Calls (Synchronous Mode, CR without Callback) stall the other Buses in this Mode.
+		bool poll(int timeoutMs);
+
+		// Post - Runs task(context) on the Thread of the Bus (before its next handleCommunication); false if the Queue is full
+		bool post(uint8_t bus, gnMsup1BusManager::Task task, void* context);
+
+		// CurrentBus - Index of the Bus whose Thread runs the Caller (e.g. a Service-Callback shared by all Buses); -1 outside
+		static int currentBus() {return _currentBus;};
+
+		// Lock - Shared Mutex for the Application's State touched by Callbacks of several Buses
+		void lock() {pthread_mutex_lock(&_sharedMutex);};
+		void unlock() {pthread_mutex_unlock(&_sharedMutex);};
+
+	private:
+		typedef uint32_t (*StepFunction) (void* bus);																							// handleCommunication(); returns the next Deadline of the Bus
+		template <class Bus> static uint32_t _step(void* bus) {
+			Bus* instance = static_cast<Bus*>(bus);
+			instance->handleCommunication();
+			return instance->nextDeadline();
+		}
+
+		struct						_bus_t {
+												gnMsup1BusManager*			manager;
+												uint8_t									index;
+												void*										bus;
+												StepFunction						step;
+												gnMsup1PosixTransport*	transport;
+												pthread_t								thread;
+												int											wake[2];														// Pipe; a posted Task wakes the Bus from poll()
+												pthread_mutex_t					taskMutex;
+												Task										tasks[GNMSUP1_BUSMANAGER_TASKQUEUE];
+												void*										contexts[GNMSUP1_BUSMANAGER_TASKQUEUE];
+												uint8_t									taskHead;
+												uint8_t									taskCount;
+												uint32_t								deadline;														// nextDeadline() after the last Step ...
+												uint32_t								deadlineTimestamp;									// ... and when it was taken
+												bool										hangup;															// The Port reported a Hang-up or Error in the last poll()
+											};
+		_bus_t						_buses[GNMSUP1_BUSMANAGER_MAXBUSES];
+		uint8_t						_busCount = 0;
+		std::atomic<bool>			_running{false};																										// start() and poll() exclude each other: a Bus is served by one Thread only
+		std::atomic<bool>			_polling{false};
+		pthread_mutex_t		_sharedMutex = PTHREAD_MUTEX_INITIALIZER;
+		static thread_local int _currentBus;
+
+		int _attach(void* bus, StepFunction step, gnMsup1PosixTransport* transport);
+		static void* _run(void* bus);
+		static void _serve(_bus_t& bus);
+		static uint32_t _remaining(_bus_t& bus);
+		static int _pollTimeout(uint32_t deadline);
+		static int _watch(_bus_t& bus, struct pollfd& descriptor, int timeout);
+		static void _checkHangup(_bus_t& bus, const struct pollfd& descriptor);
+};
+#endif	// #ifdef GNMSUP1_PLATFORM_POSIX
+#endif	// #ifndef gnMsup1BusManager_h
@@ -0,0 +1,82 @@
+/*  GN Master Slave Universal Protocol Library
+ *  ==========================================
+ *
+ *  Library for generic Master/Slave Communications.
+ *
+ *  CRC16 (CCITT: Polynomial 0x1021, Initial 0xFFFF, not reflected), computed incrementally while a Frame is decoded
+ *  or encoded. AVR uses the optimized _crc_xmodem_update of the avr-libc, other Targets a 256-Entry Table; the POSIX
+ *  Host processes Blocks slice-by-4.
+ *
+ *	MIT License
+ *
+ *	Copyright (c) 2018 Andreas Gloor
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+
+
+ // Assure the Library gets loaded not more than once
+#ifndef gnMsup1Crc16_h
+#define gnMsup1Crc16_h
+
+
+
+// Internal defines
+#define GNMSUP1_CRC16INITIAL								0xFFFF
+
+
+
+// Include necessary Library's
+#include "gnMsup1Platform.h"
+
+#ifdef __AVR__
+	#include <util/crc16.h>
+#endif
+
+
+
+// CRC16 CCITT
+class gnMsup1Crc16 {
+	public:
+		// Update - Folds one Byte into the CRC
+		static inline uint16_t update(uint16_t crc, uint8_t value) {
+			#ifdef __AVR__
+				return _crc_xmodem_update(crc, value);
+			#else
+				return (crc << 8) ^ _table[0][(crc >> 8) ^ value];
+			#endif
+		};
+
+		// Update - Folds a Block into the CRC
+		static uint16_t update(uint16_t crc, const uint8_t data[], size_t length);
+
+		// Compute - CRC of a whole Block
+		static uint16_t compute(const uint8_t data[], size_t length) {return update(GNMSUP1_CRC16INITIAL, data, length);};
+
+	#ifndef __AVR__
+	private:
+		#ifdef GNMSUP1_PLATFORM_POSIX
+			static const uint16_t	_table[4][256];																							// Slice-by-4: Table n = CRC of a Byte followed by n Zero-Bytes
+		#else
+			static const uint16_t	_table[1][256];
+		#endif
+	#endif
+};
+#endif	// #ifndef gnMsup1Crc16_h
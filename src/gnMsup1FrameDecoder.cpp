@@ -0,0 +1,198 @@
+/*  GN Master Slave Universal Protocol Library
+ *  ==========================================
+ *
+ *  Library for generic Master/Slave Communications.
+ *
+ *  Frame-Decoder (see gnMsup1FrameDecoder.h).
+ *
+ *	MIT License
+ *
+ *	Copyright (c) 2018 Andreas Gloor
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+
+
+// Include necessary Library's
+#include "gnMsup1FrameDecoder.h"
+
+
+
+// Successor per State: Row 0 for Frames without ServiceFlag (Header ends with the Address), Row 1 with ServiceFlag
+const gnMsup1FrameDecoder::State gnMsup1FrameDecoder::_nextState[2][gnMsup1FrameDecoder::StateCount] = {
+	{StateStart2, StateFlag, StateAddress, StateChecksumHigh, StateChecksumHigh, StateChecksumHigh, StateChecksumHigh,
+	 StateChecksumHigh, StateChecksumLow, StateStop1, StateStop2, StateComplete, StateStart1},
+	{StateStart2, StateFlag, StateAddress, StatePayloadSize, StateService, StateSubservice, StatePayload,
+	 StateChecksumHigh, StateChecksumLow, StateStop1, StateStop2, StateComplete, StateStart1}
+};
+
+
+
+// Feed -> Consumes Bytes until the Chunk is used up, a Frame is complete or a Frame got dropped; returns the consumed Count
+size_t gnMsup1FrameDecoder::feed(const uint8_t data[], size_t length, uint32_t nowMicros) {
+	_nowMicros = nowMicros;
+	if (_idleGapMicros == 0) {
+		return _feed(data, length);
+	}
+	
+	if (_idleSeen && _idleMicros - _lastFeedMicros >= _idleGapMicros) {																// Line was idle: ends a partial Frame, the next Byte may start one
+		_awaitIdle = false;
+		if (inFrame()) {
+			_idleSeen = false;
+			_lastFeedMicros = nowMicros;
+			drop(DropIdleGap);
+			return 0;
+		}
+	}
+	_idleSeen = false;
+	_lastFeedMicros = nowMicros;
+	
+	if (_awaitIdle) {																																						// Rest of a broken Frame: skip it in one Go
+		_event = EventNone;
+		_dropReason = DropNone;
+		return length;
+	}
+	
+	size_t position = _feed(data, length);
+	if (_event == EventDrop && _dropReason != DropStart2) {																		// Dropped within a Frame: resync on the next Gap only
+		_state = StateStart1;
+		_awaitIdle = true;
+	}
+	return position;
+}
+
+
+
+// _Feed -> Frame State-Machine
+size_t gnMsup1FrameDecoder::_feed(const uint8_t data[], size_t length) {
+	size_t position = 0;
+	_event = EventNone;
+	_dropReason = DropNone;
+
+	if (_state == StateComplete) {																															// The previous Frame was not released; start over
+		_state = StateStart1;
+	}
+
+	while (position < length) {
+		if (_state == StateStart1) {																															// Hunt for StartByte 1, skip the Junk in one Go
+			const uint8_t* start = (const uint8_t*)memchr(&data[position], GNMSUP1_FRAMESTART1, length - position);
+			if (!start) {
+				return length;
+			}
+			position = (start - data) + 1;
+			_state = StateStart2;
+			continue;
+		}
+
+		if (_state == StatePayload) {																															// Payload: copy as much as the Chunk provides
+			size_t count = _buffer[GNMSUP1_FRAMEBUF_PAYLOADSIZE] - _payloadPosition;
+			if (count > length - position) {
+				count = length - position;
+			}
+			memcpy(&_buffer[GNMSUP1_FRAMEBUF_PAYLOADSTART + _payloadPosition], &data[position], count);
+			_crc = gnMsup1Crc16::update(_crc, &data[position], count);
+			_payloadPosition += count;
+			position += count;
+			if (_payloadPosition == _buffer[GNMSUP1_FRAMEBUF_PAYLOADSIZE]) {
+				_state = StateChecksumHigh;
+			}
+			continue;
+		}
+
+		uint8_t value = data[position++];
+		switch (_state) {
+			case StateStart2:																																				// StartByte 2; the Frame-Timeout starts here
+				if (value != GNMSUP1_FRAMESTART2) {
+					_dropAt(value, DropStart2);
+					return position;
+				}
+				_startTime = _nowMicros;
+				_crc = GNMSUP1_CRC16INITIAL;
+				break;
+
+			case StateFlag:																																					// Flag; selects the Row of the Transition-Table
+				_buffer[GNMSUP1_FRAMEBUF_FLAG] = value;
+				_buffer[GNMSUP1_FRAMEBUF_PAYLOADSIZE] = 0;
+				_crc = gnMsup1Crc16::update(_crc, value);
+				break;
+
+			case StatePayloadSize:																																	// Payload-Length; drop what doesn't fit the Buffer
+				if (value > _maxPayload) {
+					_dropAt(value, DropOversize);
+					return position;
+				}
+				_buffer[GNMSUP1_FRAMEBUF_PAYLOADSIZE] = value;
+				_payloadPosition = 0;
+				_crc = gnMsup1Crc16::update(_crc, value);
+				break;
+
+			case StateAddress:																																			// Address, Service, Subservice: plain Header-Bytes
+			case StateService:
+			case StateSubservice:
+				_buffer[_state - StateFlag] = value;
+				_crc = gnMsup1Crc16::update(_crc, value);
+				break;
+
+			case StateChecksumHigh:
+				_checksum = value << 8;
+				break;
+
+			case StateChecksumLow:
+				_checksum |= value;
+				break;
+
+			case StateStop1:
+				if (value != GNMSUP1_FRAMESTOP1) {
+					_dropAt(value, DropStop1);
+					return position;
+				}
+				break;
+
+			case StateStop2:																																				// StopByte 2: Frame complete, hand it to the Caller
+				if (value != GNMSUP1_FRAMESTOP2) {
+					_dropAt(value, DropStop2);
+					return position;
+				}
+				_state = StateComplete;
+				_event = EventFrame;
+				return position;
+
+			default:
+				break;
+		}
+
+		_state = _nextState[serviceFrame()][_state];
+		if (_state == StatePayload && _buffer[GNMSUP1_FRAMEBUF_PAYLOADSIZE] == 0) {								// Empty Payload: straight to the Checksum
+			_state = StateChecksumHigh;
+		}
+	}
+
+	return position;
+}
+
+
+
+// DropAt -> Drops the current Frame; a StartByte 1 as offending Byte starts the next one
+void gnMsup1FrameDecoder::_dropAt(uint8_t value, gnMsup1FrameDecoder::DropReason reason) {
+	drop(reason);
+	if (value == GNMSUP1_FRAMESTART1) {
+		_state = StateStart2;
+	}
+}
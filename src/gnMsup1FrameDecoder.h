@@ -0,0 +1,131 @@
+/*  GN Master Slave Universal Protocol Library
+ *  ==========================================
+ *
+ *  Library for generic Master/Slave Communications.
+ *
+ *  Frame-Decoder: explicit State-Machine, fed with whole Chunks of received Bytes. Resyncs on the StartBytes by
+ *  scanning (memchr) and copies the Payload in Blocks. The CRC16 is folded in while the Bytes arrive.
+ *  Optional Idle-Gap Resync: a Gap on the Line ends a partial Frame at once, and after a Drop the Junk up to the next Gap
+ *  is skipped (no false Starts on 0xAA 0x55 within a Payload).
+ *
+ *	MIT License
+ *
+ *	Copyright (c) 2018 Andreas Gloor
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+
+
+ // Assure the Library gets loaded not more than once
+#ifndef gnMsup1FrameDecoder_h
+#define gnMsup1FrameDecoder_h
+
+
+
+// Internal defines
+#define GNMSUP1_FRAMEFLAG_DIRECTION					7
+#define GNMSUP1_FRAMEFLAG_SERVICE						6
+#define GNMSUP1_FRAMEFLAG_PUSH							5
+#define GNMSUP1_FRAMEFLAG_COMMITRECEIVE			4
+#define GNMSUP1_FRAMESTART1									0xAA
+#define GNMSUP1_FRAMESTART2									0x55
+#define GNMSUP1_FRAMESTOP1									0xCC
+#define GNMSUP1_FRAMESTOP2									0x33
+#define GNMSUP1_FRAMEBUF_FLAG								0
+#define GNMSUP1_FRAMEBUF_ADDRESS						1
+#define GNMSUP1_FRAMEBUF_PAYLOADSIZE				2
+#define GNMSUP1_FRAMEBUF_SERVICE						3
+#define GNMSUP1_FRAMEBUF_SUBSERVICE					4
+#define GNMSUP1_FRAMEBUF_PAYLOADSTART				5
+
+
+
+// Include necessary Library's
+#include "gnMsup1Platform.h"
+#include "gnMsup1Crc16.h"
+
+
+
+// Frame-Decoder
+class gnMsup1FrameDecoder {
+	public:
+		enum State					{StateStart1, StateStart2, StateFlag, StateAddress, StatePayloadSize, StateService, StateSubservice,
+												 StatePayload, StateChecksumHigh, StateChecksumLow, StateStop1, StateStop2, StateComplete, StateCount};
+		enum Event					{EventNone, EventFrame, EventDrop};
+		enum DropReason			{DropNone, DropStart2, DropOversize, DropStop1, DropStop2, DropTimeout, DropIdleGap};
+
+		// Constructor - Decodes into frameBuffer (Header + maxPayload Bytes, see GNMSUP1_FRAMEBUF_*)
+		gnMsup1FrameDecoder(uint8_t frameBuffer[], uint16_t maxPayload) : _buffer(frameBuffer), _maxPayload(maxPayload) {};
+
+		// Feed - Consumes Bytes until the Chunk is used up, a Frame is complete or a Frame got dropped; returns the consumed Count
+		//        nowMicros: Timestamp of the Bytes (e.g. the cached one of the Pass); Start-Time and Idle-Gap rely on it
+		size_t feed(const uint8_t data[], size_t length, uint32_t nowMicros);
+		size_t feed(const uint8_t data[], size_t length) {return feed(data, length, micros());};
+
+		// SetIdleGap - Resync on Gaps of gapMicros on the Line (0 = off); needs idle() whenever the Transport is drained empty
+		void setIdleGap(uint32_t gapMicros) {_idleGapMicros = gapMicros; _awaitIdle = false;};
+		
+		// Idle - No Byte pending at nowMicros: the next Bytes arrive later. A Gap counts from the last feed() to the last idle() before
+		//        the next Bytes, so a slow Loop with Bytes piling up in the Port never looks like a Gap
+		void idle(uint32_t nowMicros) {_idleMicros = nowMicros; _idleSeen = true;};
+
+		// Event of the last feed() (and the Reason if a Frame got dropped)
+		gnMsup1FrameDecoder::Event event() {return _event;};
+		gnMsup1FrameDecoder::DropReason dropReason() {return _dropReason;};
+
+		// Buffer - Current Frame-Buffer; setBuffer continues decoding into another one (e.g. while the complete Frame gets processed)
+		uint8_t* buffer() {return _buffer;};
+		void setBuffer(uint8_t frameBuffer[]) {_buffer = frameBuffer; _state = StateStart1;};
+
+		// Reset - Drop a partial Frame (or release a complete one) and hunt for the next StartBytes
+		void reset() {_state = StateStart1;};
+		void drop(gnMsup1FrameDecoder::DropReason reason) {_state = StateStart1; _event = EventDrop; _dropReason = reason;};
+
+		// Frame Information
+		gnMsup1FrameDecoder::State state() {return _state;};
+		bool inFrame() {return _state > StateStart2 && _state < StateComplete;};
+		bool serviceFrame() {return bitRead(_buffer[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_SERVICE);};
+		uint32_t startTime() {return _startTime;};																	// micros() at StartByte 2
+		uint16_t checksum() {return _checksum;};																		// Received CRC16
+		uint16_t crc() {return _crc;};																							// CRC16 computed over the received Bytes
+		bool checksumValid() {return _checksum == _crc;};
+
+	private:
+		uint8_t*					_buffer;
+		uint16_t					_maxPayload;
+		State							_state = StateStart1;
+		Event							_event = EventNone;
+		DropReason				_dropReason = DropNone;
+		uint8_t						_payloadPosition = 0;
+		uint16_t					_checksum = 0;
+		uint16_t					_crc = GNMSUP1_CRC16INITIAL;
+		uint32_t					_startTime = 0;
+		uint32_t					_nowMicros = 0;																						// Timestamp of the current feed()
+		uint32_t					_idleGapMicros = 0;
+		uint32_t					_lastFeedMicros = 0;																			// Bytes fed till then arrived before
+		uint32_t					_idleMicros = 0;																					// Port empty then: later Bytes arrived after
+		bool							_idleSeen = false;
+		bool							_awaitIdle = false;																					// Dropped; skip the Bytes until the Line gets idle
+
+		static const State	_nextState[2][StateCount];														// Successor per State; [0] Frame without, [1] with ServiceFlag
+		size_t _feed(const uint8_t data[], size_t length);
+		void _dropAt(uint8_t value, gnMsup1FrameDecoder::DropReason reason);
+};
+#endif	// #ifndef gnMsup1FrameDecoder_h
@@ -0,0 +1,2890 @@
+/*  GN Master Slave Universal Protocol Library
+ *  ==========================================
+ *  
+ *  Library for generic Master/Slave Communications.
+ *  
+ *  Implementation of the Main Class (Template, see gnMsup1.h); included by gnMsup1.h, don't include it yourself.
+ *  
+ *  2019-07-30  V1.2.2		Andreas Gloor            Bugfix begin (correct Datatype)
+ *  2018-09-12  V1.2.1		Andreas Gloor            Bugfix pollRange (for FullyAsynchonous) and pushBlockingActive public; handleCommunication called if data available before send
+ *  2018-08-24  V1.1.1		Andreas Gloor            SourceAddress Parameter in Callback Function
+ *  2018-07-21  V1.0.1		Andreas Gloor            Initial Version
+ *  
+ *	MIT License
+ *	
+ *	Copyright (c) 2018 Andreas Gloor
+ *	
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *	
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *	
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+ 
+ 
+// Assure the Library gets loaded not more than once
+#ifndef gnMsup1Impl_h
+#define gnMsup1Impl_h
+
+
+
+// Compile-time Constants (Definitions)
+template <class Config> constexpr uint32_t gnMsup1Bus<Config>::_defaultFrameTimeout;
+template <class Config> constexpr uint32_t gnMsup1Bus<Config>::_pushTimeoutMicros;
+template <class Config> constexpr uint8_t gnMsup1Bus<Config>::_segmentSize;
+#ifndef GNMSUP1_DIRECTSERVICETABLE
+	template <class Config> constexpr uint8_t gnMsup1Bus<Config>::_serviceSlotCount;
+#endif
+
+
+
+// Public ////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+// Constructor
+#ifdef GNMSUP1_PLATFORM_ARDUINO
+template <class Config>
+gnMsup1Bus<Config>::gnMsup1Bus(HardwareSerial& device, HardwareLayer hwLayer, uint8_t rs485DePin, 	// RS485, HardwareSerial
+								 Role role) : _streamTransport(device, rs485DePin) {
+	if (hwLayer != RS485) {																														// Validate RS485
+		return;
+	}
+	_transport = &_streamTransport;																															// Store the Values
+	if (role == Master) {
+		_address = GNMSUP1_MASTERPSEUDOADDRESS;
+	}
+}
+
+template <class Config>
+gnMsup1Bus<Config>::gnMsup1Bus(SoftwareSerial& device, HardwareLayer hwLayer, uint8_t rs485DePin,	// RS485, SoftwareSerial
+								 Role role) : _streamTransport(device, rs485DePin) {
+	if (hwLayer != RS485) {																														// Validate RS485
+		return;
+	}
+	_transport = &_streamTransport;																															// Store the Values
+	if (role == Master) {
+		_address = GNMSUP1_MASTERPSEUDOADDRESS;
+	}
+}
+#endif
+
+template <class Config>
+gnMsup1Bus<Config>::gnMsup1Bus(gnMsup1Transport& transport, Role role) {												// Any Transport (POSIX, Pty, ...)
+	_transport = &transport;
+	if (role == Master) {
+		_address = GNMSUP1_MASTERPSEUDOADDRESS;
+	}
+}
+
+
+
+// Begin -> Call this Function to start the MSUP
+template <class Config>
+bool gnMsup1Bus<Config>::begin(int32_t baudRate, uint8_t address) {
+	if (!((_ownsMasterRole() && address == GNMSUP1_MASTERPSEUDOADDRESS) ||											// Validate Master/Slave-Address
+				(!_ownsMasterRole() && address < GNMSUP1_GROUPADDRESSBASE))) {
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR:INVALID ADDRESS/ROLE!"));
+			}
+		#endif
+
+		return false;
+	}
+	
+	if (!_transport || !_transport->begin(baudRate)) {																					// Open the Transport (Serial-Port and DE/RTS)
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR:TRANSPORT BEGIN FAILED!"));
+			}
+		#endif
+		
+		return false;
+	}
+	
+	_address = address;																																					// Save the Address
+	_baudrate = baudRate;
+	
+	_frameTimeout = (baudRate == Config::defaultBaudrate) ? _defaultFrameTimeout : _frameTimeoutFor(baudRate);	// Calculate Frame-Timeout (Config); computed at compile time for the Default-Baudrate
+	_adaptiveBaudrate(baudRate);
+	
+	_ignoreStore.reset();
+	_activeStore.reset();
+	_lostStore.reset();
+	_scavengingRound.reset();
+	_probePending.reset();
+	_probeAwaiting = false;
+	_discoveryActive = false;
+	
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->print(F("INIT:OK\tROLE:"));
+			if (_ownsMasterRole()) {
+				_debugStream->print(F("MASTER"));
+			} else {
+				_debugStream->print(F("SLAVE\tADDR:0x"));
+				_debugPrintHex(address);
+			}
+			_debugStream->print(F("\tTIMEOUT:"));
+			_debugStream->print(_frameTimeout);
+			_debugStream->print(F("us"));
+			_debugStream->println();
+		}
+	#endif
+			
+	_initialized = true;																																				// Set Init-Flag and return true
+	return true;
+}
+
+
+
+// HandleCommunication -> Call this Function during the loop in your Sketch; avoid long delays
+template <class Config>
+void gnMsup1Bus<Config>::handleCommunication() {
+	_handleCommunication(true);
+}
+
+
+
+// HandleCommunication -> Internal Part; the Engines (Poll) only advance from the Sketch's Loop, not while the Library waits itself
+template <class Config>
+void gnMsup1Bus<Config>::_handleCommunication(bool runEngines) {
+	if (!_initialized) {																																				// Don't proceed until initialized
+		return;
+	}
+	
+	_timer.refresh();																																						// One Timestamp for all Timers of this Pass
+	_txService(false);																																					// Release DE once the last Frame is out
+	_txReport();
+	
+	if (_crPending) {																																						// The next Bytes are the CRC16-Echo of a CommitReceive
+		_crService();
+	}
+	
+	if (!_crPending && _readInput()) {																													// Read the Input; Proceed when Frame complete & valid in Buffers
+		_processFrame();		
+	}
+	
+	if (runEngines && _baudActive) {
+		_baudService();																																						// The Baudrate-Switch pauses the other Engines (startBaudrateSwitch)
+	} else if (runEngines) {
+		#ifdef GNMSUP1_POLLSCHEDULER
+			_schedulerService();																																		// Schedule the next Slave (startScheduler)
+		#endif
+		_pollService();																																						// Advance a running Poll (startPoll)
+		_transferService();																																				// Advance a running Segmented Transfer (startTransfer)
+		_probeService();																																					// Next Probe of the Discovery or Scavenging
+	}
+	
+	if (_baudFallbackPending && !_baudWindow.running(_timer)) {																	// Switched Slave without Commit: back to the old Rate
+		_baudFallbackPending = false;
+		_setBaudrate(_baudFallbackRate);
+	}
+	
+	_scavengingInactive();																																			// Scavenging inactives (use its own Timestamp based check)
+	_pushStoreExpire();																																					// Drop Push-Messages past their Deadline
+}
+
+
+
+// NextDeadline -> Earliest Timer in Milliseconds (rounded up, for Sleeps with ms-Resolution)
+template <class Config>
+uint32_t gnMsup1Bus<Config>::nextDeadline() {
+	uint32_t deadline = nextDeadlineMicros();
+	return (deadline == GNMSUP1_NODEADLINE) ? GNMSUP1_NODEADLINE : deadline / 1000 + (deadline % 1000 != 0);
+}
+
+
+
+// NextDeadlineMicros -> Earliest Timer of the running Protocol-Steps; 0 while Work is left over (Bytes buffered, Frame on the Line, Engine ready)
+template <class Config>
+uint32_t gnMsup1Bus<Config>::nextDeadlineMicros() {
+	if (!_initialized) {
+		return GNMSUP1_NODEADLINE;
+	}
+	
+	if (_txBusy || _txCompletePending || _rxPending()) {																					// DE to release, Report outstanding, Bytes not yet decoded
+		return 0;
+	}
+	
+	_timer.refresh();
+	uint32_t deadline = GNMSUP1_NODEADLINE;
+	if (_crPending) {																																						// CRC16-Echo outstanding
+		_deadlineUpdate(deadline, _crDeadline.remaining(_timer));
+	}
+	if (_decoder.inFrame()) {																																		// Frame-Timeout drops a broken Frame
+		_deadlineUpdate(deadline, gnMsup1Timer::remaining(_timer.micros(), _decoder.startTime(), _rxFrameTimeout() + 1));
+	}
+	
+	bool engineReady = false;																																		// Engines wait for Push-Blocking (Answer or its Timeout) only
+	#ifdef GNMSUP1_POLLSCHEDULER
+		if (_schedulerActive && !_pollActive) {
+			for (uint8_t address = _schedulerBeginAddress; address <= _schedulerEndAddress && !engineReady; address++) {
+				engineReady = !_queryIgnore(address);																								// All ignored: left to the Scavenging
+			}
+		}
+	#endif
+	if (_baudActive) {																																					// The Baudrate-Switch pauses the other Engines
+		engineReady = !_baudSettle.running(_timer);
+		_deadlineUpdate(deadline, _baudSettle.remaining(_timer));
+	} else {
+		engineReady = engineReady || _pollActive || _transferActive;
+		engineReady = engineReady || (!_probeAwaiting && (_discoveryActive || (_ignoreInactiveNodes && _scavengingBudget && _scavengingRound.any())));
+	}
+	if (engineReady) {
+		if (_pushBlocking.running(_timer)) {
+			_deadlineUpdate(deadline, _pushBlocking.remaining(_timer));
+		} else if (!_crPending) {
+			return 0;
+		}
+	}
+	
+	if (_baudFallbackPending) {																																	// Fallback of a switched Slave
+		_deadlineUpdate(deadline, _baudWindow.remaining(_timer));
+	}
+	if (_pushStoreCount > 0) {																																	// Next Push-Message to expire
+		int32_t left = (int32_t)(_pushStoreExpiry - _timer.millis());
+		_deadlineUpdate(deadline, left < 0 ? 0 : ((uint32_t)left > UINT32_MAX / 1000 - 1 ? UINT32_MAX / 1000 - 1 : (uint32_t)left + 1) * 1000);
+	}
+	if (_ignoreInactiveNodes) {
+		_deadlineUpdate(deadline, gnMsup1Timer::remaining(_timer.millis(), _scavengingInactiveLastTimestamp, (uint32_t)GNMSUP1_SCAVENGINGINACTIVEINTERVAL + 1) * 1000);
+	}
+	return deadline;
+}
+
+
+
+// WaitForCommunication -> Sleeps in the Transport until Input or the next Deadline
+template <class Config>
+bool gnMsup1Bus<Config>::waitForCommunication(uint32_t maxWaitMs) {
+	uint32_t deadline = nextDeadline();
+	if (deadline > maxWaitMs) {
+		deadline = maxWaitMs;
+	}
+	if (deadline == 0) {
+		return false;
+	}
+	return _transport->waitInput(deadline);
+}
+
+
+
+// AttachService -> Attaches a Callback Function for a Service (identified by ServiceNumber)
+template <class Config>
+bool gnMsup1Bus<Config>::attachService(uint8_t serviceNumber, ServiceHandlerCallback serviceHandler) {
+	if (serviceNumber == 0xFF) {																																// Avoid register System-Service
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR:SERVICE 0xFF RESERVED FOR SYSTEM"));
+			}
+		#endif
+		return false;
+	}
+	
+	if (_lookupService(serviceNumber)) {																												// Check if already attached
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->print(F("ERR:SERVICE 0x"));
+				_debugPrintHex(serviceNumber);
+				_debugStream->println(F(" ALREADY ATTACHED"));
+			}
+		#endif
+		return false;
+	}
+	
+	#ifdef GNMSUP1_DIRECTSERVICETABLE																														// Store the Callback in the Dispatch-Table
+		_serviceTable[serviceNumber] = serviceHandler;
+	#else
+		if (_serviceCount >= Config::maxServiceCount) {
+			#ifdef GNMSUP1_DEBUG
+				if (_debugAttached) {
+					_debugStream->println(F("ERR:SERVICE STORE FULL (Config::maxServiceCount)"));
+				}
+			#endif
+			return false;
+		}
+		
+		uint8_t slot = serviceNumber & (_serviceSlotCount - 1);
+		while (_serviceSlots[slot].serviceHandler) {
+			slot = (slot + 1) & (_serviceSlotCount - 1);
+		}
+		_serviceSlots[slot].serviceNumber = serviceNumber;
+		_serviceSlots[slot].serviceHandler = serviceHandler;
+	#endif
+	_serviceCount++;
+	
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->print(F("SERVICE 0x"));
+			_debugPrintHex(serviceNumber);
+			_debugStream->println(F(" ATTACHED"));
+		}
+	#endif
+	return true;
+}
+
+
+
+// AttachServiceTable -> Attaches a compile-time Table of Services (sorted ascending by ServiceNumber)
+template <class Config>
+bool gnMsup1Bus<Config>::attachServiceTable(const ServiceEntry table[], uint8_t count) {
+	ServiceEntry previous;
+	for (uint8_t i = 0; i < count; i++) {																												// Validate Order and reserved System-Service
+		ServiceEntry entry;
+		gnMsup1MemcpyFlash(&entry, &table[i], sizeof(entry));
+		if (entry.serviceNumber == GNMSUP1_SYSTEMSERVICENUMBER || (i > 0 && entry.serviceNumber <= previous.serviceNumber)) {
+			#ifdef GNMSUP1_DEBUG
+				if (_debugAttached) {
+					_debugStream->print(F("ERR:SERVICE-TABLE UNSORTED OR RESERVED AT ENTRY "));
+					_debugStream->println(i);
+				}
+			#endif
+			return false;
+		}
+		previous = entry;
+	}
+	
+	_serviceStaticTable = table;
+	_serviceStaticCount = count;
+	return true;
+}
+
+
+
+// Push -> Sends a Frame back to Master; keep in mind to poll the messages in your master code
+template <class Config>
+bool gnMsup1Bus<Config>::push(uint8_t serviceNumber, uint8_t subserviceNumber, uint8_t payload[], uint8_t payloadSize, bool commitReceivedFlag, PushPriority priority, uint32_t lifetimeMs) {
+	if (_ownsMasterRole() || !_initialized) {																										// Only Slave is permitted to use this Function; only if initialized
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println();
+				_debugStream->println(F("ERR: PUSH ONLY USABLE IN SLAVE ROLE, AFTER BEGIN."));
+			}
+		#endif
+		
+		return false;
+	}
+	
+	_timer.refresh();																																						// Called from the Sketch: Timestamp of the Entry
+	_pushStore_t* storeEntry = _pushStoreEnqueue(priority, lifetimeMs);																		// Check if Space in Store (or a less urgent Entry to drop)
+	if (!storeEntry) {
+		if (_blockingMode == FullyAsynchronous) {																				// FullyAsynchonous fails if Store runs out of space
+			#ifdef GNMSUP1_DEBUG
+				if (_debugAttached) {
+					_debugStream->println();
+					_debugStream->print(F("ERR: PUSH FRAME TO MASTER"));
+					_debugStream->print(F(", SERVICE 0x"));
+					_debugPrintHex(serviceNumber);
+					_debugStream->print(F(", SUBSERVICE 0x"));
+					_debugPrintHex(subserviceNumber);
+					_debugStream->print(F(", PAYLOAD-SIZE 0x"));
+					_debugPrintHex(payloadSize);
+					_debugStream->print(F(" -> PUSH-QEUE OUT OF SPACE"));
+					_debugStream->println();
+				}
+			#endif
+			
+			_statisticsCount(_address, &Statistics::pushQueueDrops);
+			return false;
+		} else {																																									// NearlyAsynchronous waits till a space in queue gets free (due to a call or timeout)
+			#ifdef GNMSUP1_DEBUG
+				if (_debugAttached) {
+					_debugStream->println();
+					_debugStream->println(F("WRN:PUSH-QEUE OUT OF SPACE, WAIT FOR MASTER OR TIMEOUT. AVOID THIS CONDITION!"));
+				}
+			#endif
+			
+			while (!storeEntry) {
+				_handleCommunication(false);
+				storeEntry = _pushStoreEnqueue(priority, lifetimeMs);
+			}
+		}
+	}
+	
+	bitWrite(storeEntry->flags, GNMSUP1_PUSHBUFFLAG_COMMITRECEIVE, commitReceivedFlag);											// Add the Entry to the Store
+	storeEntry->serviceNumber = serviceNumber;
+	storeEntry->subserviceNumber = subserviceNumber;
+	storeEntry->payloadSize = payloadSize;
+	memcpy(storeEntry->payload, payload, payloadSize);
+	
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->println();
+			_debugStream->print(F("PUSH:SERVICE 0x"));
+			_debugPrintHex(serviceNumber);
+			_debugStream->print(F(", SUBSERVICE 0x"));
+			_debugPrintHex(subserviceNumber);
+			_debugStream->print(F(", PAYLOAD-SIZE 0x"));
+			_debugPrintHex(payloadSize);
+		}
+	#endif
+	
+	if (_blockingMode == Synchronous) {																								// Synchronous waits until the Message was delivered to Master or timeouts
+		#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->println(F(" -> MODE ENFORCE BLOCKING WAIT."));
+		}
+		#endif
+		
+		PushIndex storeSlot = storeEntry - _pushStore;
+		uint16_t storeTicket = storeEntry->ticket;
+		while (_pushStoreQueued(storeSlot, storeTicket)) {																					// Wait until the Entry got delivered or expired
+			_handleCommunication(false);
+			_pushStoreFront();
+		}
+	} else {																																										// Other Modes work with regular Qeue
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F(" -> ADDED TO PUSH-QEUE"));
+			}
+		#endif		
+	}
+	return true;
+}
+
+
+
+// Send -> Sends a Frame to a Slave
+template <class Config>
+bool gnMsup1Bus<Config>::send(uint8_t address, uint8_t serviceNumber, uint8_t subserviceNumber, uint8_t payload[], uint8_t payloadSize, bool pushFlag, bool commitReceivedFlag, bool retryOnCrFailure, CommitReceiveCallback commitReceiveHandler) {
+	if (!_ownsMasterRole() || !_initialized) {																									// Only Master is permitted to use this Function; only if initialized
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println();
+				_debugStream->println(F("ERR: PUSH ONLY USABLE IN MASTER ROLE, AFTER BEGIN."));
+			}
+		#endif
+		
+		return false;
+	}
+	
+	if (_isGroupAddress(address)) {																															// Broadcast/Multicast: nobody answers, so no CR and no Push
+		pushFlag = false;
+		commitReceivedFlag = false;
+	} else if (address > Config::maxSlaveAddress) {
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR: SLAVE ADDRESS OUT OF RANGE."));
+			}
+		#endif
+		return false;
+	}
+	
+	if (pushBlockingActive()) {																																	// Blocking Mode dependent behavior if a push-request is pending 
+		if (_blockingMode == FullyAsynchronous) {																				// FullyAsynchronous fails if another Request is active
+			#ifdef GNMSUP1_DEBUG
+				if (_debugAttached) {
+					_debugStream->println();
+					_debugStream->println(F("ERR: PUSH-ANSWER OPEN; FULLYASYNCHRONOUS DOESN'T ALLOW TO CALL SEND."));
+				}
+			#endif
+		
+			return false;
+		} else {																																									// The other modes wait for Answer or Timeout
+			_pushBlockingWaitForRelease();
+		}
+	}
+	
+	bool waitForPushAnswer = (_blockingMode == Synchronous);														// Only Synchronous Mode waits for a Answer
+	
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->println();
+			_debugStream->print(F("SEND FRAME TO 0x"));
+			_debugPrintHex(address);
+			_debugStream->print(F(", SERVICE 0x"));
+			_debugPrintHex(serviceNumber);
+			_debugStream->print(F(", SUBSERVICE 0x"));
+			_debugPrintHex(subserviceNumber);
+			_debugStream->print(F(", PAYLOAD-SIZE 0x"));
+			_debugPrintHex(payloadSize);
+			if (pushFlag) {
+				_debugStream->print(F(", PUSHFLAG SET"));
+			}
+			if (commitReceivedFlag) {
+				_debugStream->print(F(", WITH CR"));
+			}			
+			_debugStream->println();
+		}
+	#endif
+	
+	return _sendFrame(address, serviceNumber, subserviceNumber, true, pushFlag, waitForPushAnswer, commitReceivedFlag, retryOnCrFailure, payload, payloadSize, commitReceiveHandler);
+}
+
+
+
+// PollRange -> Sends Push-Request to a Slave or a Range of Slaves
+template <class Config>
+bool gnMsup1Bus<Config>::pollRange(uint8_t beginAddress, uint8_t endAddress, uint8_t maxMessagesPerSlave, bool commitReceivedFlag, bool retryOnCrFailure) {
+	if (!_ownsMasterRole() || !_initialized) {																									// Only Master is permitted to use this Function; only if initialized
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR: PUSH ONLY USABLE IN MASTER ROLE, AFTER BEGIN."));
+			}
+		#endif
+		return false;
+	}
+	
+	if (endAddress > Config::maxSlaveAddress) {
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR: SLAVE ADDRESS OUT OF RANGE."));
+			}
+		#endif
+		return false;
+	}
+	
+	if (maxMessagesPerSlave < 1) {																															// Minimum 1 Message per Slave
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR: PUSH MINIMUM 1 MESSAGE PER SLAVE."));
+			}
+		#endif
+		return false;
+	}
+	
+	if (maxMessagesPerSlave > 1 && _blockingMode == FullyAsynchronous) {								// Maximum 1 Message per Slave in FullyAsynchonous
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR: PUSH MAXIMUM 1 MESSAGE PER SLAVE IN FULLYASYNCHRONOUS MODE."));
+			}
+		#endif
+		return false;
+	}
+	
+	if (_blockingMode == FullyAsynchronous && beginAddress != endAddress) {						// FullyAsynchronous Mode doesn't allow range-polling
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR: FULLYASYNCHRONOUS DOESN'T ALLOW RANGE POLLING."));
+			}
+		#endif
+		
+		return false;
+	}
+	
+	if (pushBlockingActive()) {																																	// Blocking Mode dependent behavior if a push-request is pending 
+		if (_blockingMode == FullyAsynchronous) {																				// FullyAsynchronous fails if another Request is active
+			#ifdef GNMSUP1_DEBUG
+				if (_debugAttached) {
+					_debugStream->println();
+					_debugStream->println(F("ERR: PUSH-ANSWER OPEN; FULLYASYNCHRONOUS DOESN'T ALLOW TO CALL ANOTHER POLL."));
+				}
+			#endif
+		
+			return false;
+		} else {																																									// The other modes wait for Answer or Timeout
+			_pushBlockingWaitForRelease();
+		}
+	}
+	
+	bool returnValue = true;
+	uint8_t payload[0];
+	bool waitForPushAnswer = false;
+	
+	for (uint8_t address = beginAddress; address <= endAddress; address++) {
+		for (uint8_t remainingMessages = maxMessagesPerSlave;																			// Iterate all remainingMessages per Slave
+					remainingMessages > 0; remainingMessages--) {
+		
+			switch (_blockingMode) {																																// Determine the Wait for Push Answer:
+				case FullyAsynchronous:																											// FullyAsynchronous never waits
+					waitForPushAnswer = false;
+					break;
+				case NearlyAsynchronous:																											// NearlyAsynchronous doesn't wait the last
+					waitForPushAnswer = (!((address == endAddress) && (remainingMessages <= 1)));
+					break;
+				default:																																							// Synchronous always waits
+					waitForPushAnswer = true;
+			}
+		
+			#ifdef GNMSUP1_DEBUG
+				if (_debugAttached) {
+					_debugStream->println();
+					_debugStream->print(F("SEND PUSH-REQUEST TO 0x"));
+					_debugPrintHex(address);
+					_debugStream->print(F(", WAIT:"));
+					_debugStream->print(waitForPushAnswer);
+					_debugStream->print(F(", MAXMSG:"));
+					_debugStream->print(remainingMessages);
+					_debugStream->print(F(", CR:"));
+					_debugStream->println(commitReceivedFlag);					
+				}
+			#endif
+			
+			_additionalPushMsgAvailable = false;																										// Reset the Flag for additional Messages
+
+			if (!_sendFrame(address, 0, 0, false, true, waitForPushAnswer, commitReceivedFlag, retryOnCrFailure, payload, 0)) {	// Send the Frame
+				returnValue = false;
+				
+				#ifdef GNMSUP1_DEBUG
+					if (_debugAttached) {
+						_debugStream->print(F("ERR: SEND PUSH-REQUEST TO 0x"));
+						_debugPrintHex(address);
+						_debugStream->println(F(" FAILED!"));
+					}
+				#endif
+			}
+			
+			if (!_additionalPushMsgAvailable) {																											// Break remainingMessages for, if this was the last message (-- occurs bevor for checks the condition again, so this gives a zero and falls out of for...)
+				remainingMessages = 1;
+			}
+		}
+	}
+	return returnValue;
+}
+
+
+
+// StartPoll -> Starts a non-blocking Poll of a Slave or a Range of Slaves; handleCommunication sends one Push-Request at a Time
+template <class Config>
+bool gnMsup1Bus<Config>::startPoll(uint8_t beginAddress, uint8_t endAddress, uint8_t maxMessagesPerSlave, bool commitReceivedFlag) {
+	if (!_ownsMasterRole() || !_initialized || _pollActive ||																		// Only Master is permitted to use this Function; only if initialized and no Poll running
+			endAddress > Config::maxSlaveAddress || beginAddress > endAddress || maxMessagesPerSlave < 1) {
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR: STARTPOLL REJECTED (ROLE, RANGE OR POLL RUNNING)."));
+			}
+		#endif
+		return false;
+	}
+	
+	_pollActive = true;
+	_pollAwaiting = false;
+	_pollBeginAddress = beginAddress;
+	_pollEndAddress = endAddress;
+	_pollAddress = beginAddress;
+	_pollMaxMessages = maxMessagesPerSlave;
+	_pollRemainingMessages = maxMessagesPerSlave;
+	_pollCommitReceive = commitReceivedFlag;
+	_pollMessages = 0;
+	return true;
+}
+
+
+
+// PollService -> Advances the running Poll: next Request once the previous one got answered or timeouted (Config::pushTimeout)
+template <class Config>
+void gnMsup1Bus<Config>::_pollService() {
+	if (!_pollActive || _pushBlocking.running(_timer) || _crPending) {
+		return;
+	}
+	
+	if (_pollAwaiting) {																																				// Previous Request done; same Slave again if it has more Messages
+		_pollAwaiting = false;
+		if (!_additionalPushMsgAvailable || --_pollRemainingMessages == 0) {
+			bool reportCompletion = true;
+			#ifdef GNMSUP1_POLLSCHEDULER
+				if (_schedulerActive) {																																// Feed the Scheduler (polls a single Slave per Poll, no Completion-Callback)
+					_schedulerUpdate(_pollAddress, _pollMessages, _additionalPushMsgAvailable);
+					reportCompletion = false;
+				}
+			#endif
+			_pollMessages = 0;
+			if (_pollAddress == _pollEndAddress) {																									// Range done
+				_pollActive = false;
+				#ifdef GNMSUP1_DEBUG
+					if (_debugAttached) {
+						_debugStream->println(F("POLL COMPLETED"));
+					}
+				#endif
+				if (_pollCompleteHandler && reportCompletion) {
+					_pollCompleteHandler(_pollBeginAddress, _pollEndAddress);
+				}
+				return;
+			}
+			_pollAddress++;
+			_pollRemainingMessages = _pollMaxMessages;
+		}
+	}
+	
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->println();
+			_debugStream->print(F("POLL: SEND PUSH-REQUEST TO 0x"));
+			_debugPrintHex(_pollAddress);
+			_debugStream->print(F(", MAXMSG:"));
+			_debugStream->println(_pollRemainingMessages);
+		}
+	#endif
+	
+	uint8_t empty[0];
+	_additionalPushMsgAvailable = false;																												// Reset the Flag for additional Messages
+	_pollAwaiting = true;
+	if (!_sendFrame(_pollAddress, 0, 0, false, true, false, _pollCommitReceive, false, empty, 0)) {				// Ignored Node or CR failed: no Answer to wait for
+		_pushBlockingRelease();
+	}
+}
+
+
+
+#ifdef GNMSUP1_POLLSCHEDULER
+// StartScheduler -> Starts polling a Range of Slaves continuously, weighted by their learned Push-Rate
+template <class Config>
+bool gnMsup1Bus<Config>::startScheduler(uint8_t beginAddress, uint8_t endAddress, uint8_t maxMessagesPerSlave, bool commitReceivedFlag) {
+	if (!_ownsMasterRole() || !_initialized ||																									// Only Master is permitted to use this Function; only if initialized
+			endAddress > Config::maxSlaveAddress || beginAddress > endAddress || maxMessagesPerSlave < 1) {
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR: STARTSCHEDULER REJECTED (ROLE OR RANGE)."));
+			}
+		#endif
+		return false;
+	}
+	
+	uint32_t millisbuffer = _timer.millis();
+	for (uint8_t i = beginAddress; i <= endAddress; i++) {																				// Start unbiased: everybody idle, first Round polls everybody
+		_schedulerRate[i] = 0;
+		_schedulerDeficit[i] = 0;
+		_schedulerLastPoll[i] = millisbuffer - _schedulerFloorInterval;
+	}
+	_schedulerBeginAddress = beginAddress;
+	_schedulerEndAddress = endAddress;
+	_schedulerAddress = endAddress;
+	_schedulerMaxMessages = maxMessagesPerSlave;
+	_schedulerCommitReceive = commitReceivedFlag;
+	_schedulerActive = true;
+	return true;
+}
+
+
+
+// SchedulerService -> Picks the next Slave once the Poll-Engine is idle: Floor-Interval due, or Deficit-Round-Robin by Weight
+template <class Config>
+void gnMsup1Bus<Config>::_schedulerService() {
+	if (!_schedulerActive || _pollActive) {
+		return;
+	}
+	
+	uint32_t millisbuffer = _timer.millis();
+	uint8_t address = _schedulerAddress;
+	uint16_t visits = (uint16_t)(_schedulerEndAddress - _schedulerBeginAddress + 1) * _schedulerMaxWeight;	// Every Slave reaches the Cost within maxWeight Rounds
+	for (; visits > 0; visits--) {
+		address = (address >= _schedulerEndAddress) ? _schedulerBeginAddress : address + 1;
+		if (_queryIgnore(address)) {																															// Inactive Nodes are left to the Scavenging
+			continue;
+		}
+		if (millisbuffer - _schedulerLastPoll[address] >= _schedulerFloorInterval) {						// Floor-Frequency for idle Slaves
+			break;
+		}
+		uint8_t weight = 1 + (uint8_t)(((uint32_t)_schedulerRate[address] * (_schedulerMaxWeight - 1)) >> 8);	// 1 (idle) .. maxWeight (>= 1 Message per Poll)
+		if (weight > _schedulerMaxWeight) {
+			weight = _schedulerMaxWeight;
+		}
+		_schedulerDeficit[address] += weight;
+		if (_schedulerDeficit[address] >= _schedulerMaxWeight) {																// Cost of a Poll: maxWeight
+			break;
+		}
+	}
+	if (visits == 0) {																																				// Nothing to poll (all ignored)
+		return;
+	}
+	
+	_schedulerAddress = address;
+	_schedulerDeficit[address] = 0;
+	_schedulerLastPoll[address] = millisbuffer;
+	startPoll(address, address, _schedulerMaxMessages, _schedulerCommitReceive);
+}
+
+
+
+// SchedulerUpdate -> Learns the Push-Rate (EWMA 1/8, Messages per Poll in 8.8); a remaining Backlog gets the Slave polled next Round
+template <class Config>
+void gnMsup1Bus<Config>::_schedulerUpdate(uint8_t address, uint8_t messages, bool backlog) {
+	int32_t sample = (uint32_t)messages << 8;
+	_schedulerRate[address] += (int32_t)(sample - _schedulerRate[address]) / 8;
+	if (backlog) {
+		_schedulerDeficit[address] = _schedulerMaxWeight;
+	}
+}
+#endif
+
+
+
+// StartTransfer -> Starts a Segmented Transfer of a Buffer to a Slave; handleCommunication sends one Window at a Time
+template <class Config>
+bool gnMsup1Bus<Config>::startTransfer(uint8_t address, uint8_t serviceNumber, uint8_t subserviceNumber, const uint8_t data[], uint32_t length, TransferCompleteCallback completeHandler) {
+	if (!_transferStart(address, serviceNumber, subserviceNumber, length, completeHandler)) {
+		return false;
+	}
+	_transferData = data;
+	_transferSource = nullptr;
+	return true;
+}
+
+template <class Config>
+bool gnMsup1Bus<Config>::startTransfer(uint8_t address, uint8_t serviceNumber, uint8_t subserviceNumber, TransferSourceCallback source, uint32_t length, TransferCompleteCallback completeHandler) {
+	if (!_transferStart(address, serviceNumber, subserviceNumber, length, completeHandler)) {
+		return false;
+	}
+	_transferData = nullptr;
+	_transferSource = source;
+	return true;
+}
+
+
+
+// TransferStart -> Validates and initializes a Segmented Transfer (without the Data-Source)
+template <class Config>
+bool gnMsup1Bus<Config>::_transferStart(uint8_t address, uint8_t serviceNumber, uint8_t subserviceNumber, uint32_t length, TransferCompleteCallback completeHandler) {
+	static_assert(Config::maxPayloadBuffer >= GNMSUP1_SEGMENT_BEGINSIZE, "startTransfer: Config::maxPayloadBuffer can't hold the Begin-Segment");
+	if (!_ownsMasterRole() || !_initialized || _transferActive ||																	// Only Master is permitted to use this Function; only if initialized and no Transfer running
+			address > Config::maxSlaveAddress || length > 0xFFFFFFul ||																	// Length (24 Bit) limits the Size ...
+			(length + _segmentSize - 1) / _segmentSize > 0xFFFF) {																		// ... and so does the Sequence (16 Bit)
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR: STARTTRANSFER REJECTED (ROLE, ADDRESS, SIZE OR TRANSFER RUNNING)."));
+			}
+		#endif
+		return false;
+	}
+	
+	_transferActive = true;
+	_transferOpened = false;
+	_transferAwaiting = false;
+	_transferAddress = address;
+	_transferServiceNumber = serviceNumber;
+	_transferSubserviceNumber = subserviceNumber;
+	_transferRetries = 0;
+	_transferLength = length;
+	_transferSegments = (length + _segmentSize - 1) / _segmentSize;
+	_transferNext = 0;
+	_transferAcked = 0;
+	_transferCompleteHandler = completeHandler;
+	return true;
+}
+
+
+
+// TransferService -> Advances the running Transfer: evaluates the last Ack (or its Timeout) and sends the next Window
+template <class Config>
+void gnMsup1Bus<Config>::_transferService() {
+	if (!_transferActive || _pushBlocking.running(_timer) || _crPending) {
+		return;
+	}
+	
+	ComErrorCode result = None;
+	if (_transferAwaiting) {																																		// Previous Window done: Progress resets the Retries
+		_transferAwaiting = false;
+		if (_transferRejected) {
+			result = Err_TransferRejected;
+		} else if (_transferAcknowledged) {
+			_transferRetries = 0;
+		} else if (++_transferRetries > GNMSUP1_TRANSFERRETRIES) {
+			result = Err_TransferTimeout;
+		} else {
+			_statisticsCount(_transferAddress, &Statistics::retries);
+		}
+	}
+	
+	if (result != None || (_transferOpened && _transferNext == _transferSegments)) {		// Failed or every Segment received
+		_transferActive = false;
+		if (result != None) {
+			_lastComError.comErrorCode = result;
+			_lastComError.address = _transferAddress;
+		}
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(result == None ? F("TRANSFER COMPLETED") : F("ERR: TRANSFER FAILED"));
+			}
+		#endif
+		if (_transferCompleteHandler) {
+			_transferCompleteHandler(_transferAddress, result);
+		}
+		return;
+	}
+	
+	uint8_t segment[Config::maxPayloadBuffer];
+	bool sent;
+	_transferAcknowledged = false;
+	_transferRejected = false;
+	_transferAwaiting = true;
+	if (!_transferOpened) {																																			// Begin: announce Service, Segment-Size and Length; the Ack opens the Transfer
+		segment[0] = _transferServiceNumber;
+		segment[1] = _transferSubserviceNumber;
+		segment[2] = _segmentSize;
+		segment[3] = (uint8_t)(_transferLength >> 16);
+		segment[4] = (uint8_t)(_transferLength >> 8);
+		segment[5] = (uint8_t)_transferLength;
+		sent = _sendFrame(_transferAddress, GNMSUP1_SYSTEMSERVICENUMBER, GNMSUP1_SYSTEMSERVICE_SEGMENTBEGIN, true, true, false, false, false, segment, GNMSUP1_SEGMENT_BEGINSIZE);
+	} else {																																										// Window: every Segment not acknowledged yet; the last one carries the Push-Request for the Ack
+		uint16_t windowEnd = _transferNext + GNMSUP1_TRANSFERWINDOW;
+		if (windowEnd > _transferSegments || windowEnd < _transferNext) {
+			windowEnd = _transferSegments;
+		}
+		uint16_t last = windowEnd - 1;
+		while (bitRead(_transferAcked, last - _transferNext)) {																		// Segment _transferNext is never acknowledged, so this stops
+			last--;
+		}
+		
+		sent = true;
+		for (uint16_t sequence = _transferNext; sequence <= last && sent; sequence++) {
+			if (bitRead(_transferAcked, sequence - _transferNext)) {
+				continue;
+			}
+			uint32_t offset = (uint32_t)sequence * _segmentSize;
+			uint8_t length = (_transferLength - offset < _segmentSize) ? _transferLength - offset : _segmentSize;
+			segment[0] = highByte(sequence);
+			segment[1] = lowByte(sequence);
+			if (_transferData) {
+				memcpy(&segment[GNMSUP1_SEGMENT_HEADER], &_transferData[offset], length);
+			} else {
+				_transferSource(offset, &segment[GNMSUP1_SEGMENT_HEADER], length);
+			}
+			sent = _sendFrame(_transferAddress, GNMSUP1_SYSTEMSERVICENUMBER, GNMSUP1_SYSTEMSERVICE_SEGMENTDATA, true, sequence == last, false, false, false, segment, GNMSUP1_SEGMENT_HEADER + length);
+		}
+	}
+	if (!sent) {																																								// Ignored Node: no Ack to wait for (counts as Retry)
+		_pushBlockingRelease();
+	}
+}
+
+
+
+// TransferAcknowledge -> Ack of the Slave (Master): empty rejects the Transfer, otherwise next missing Segment and Bitmap from there
+template <class Config>
+void gnMsup1Bus<Config>::_transferAcknowledge(const uint8_t frame[]) {
+	if (!_transferActive || !_transferAwaiting || frame[GNMSUP1_FRAMEBUF_ADDRESS] != _transferAddress) {
+		return;
+	}
+	
+	if (frame[GNMSUP1_FRAMEBUF_PAYLOADSIZE] < GNMSUP1_SEGMENT_ACKSIZE) {
+		_transferRejected = true;
+		return;
+	}
+	
+	const uint8_t* ack = &frame[GNMSUP1_FRAMEBUF_PAYLOADSTART];
+	uint16_t next = (ack[0] << 8) | ack[1];
+	if ((int16_t)(next - _transferNext) < 0 || next > _transferSegments) {										// Stale or invalid Ack
+		return;
+	}
+	_transferNext = next;
+	_transferAcked = (ack[2] << 8) | ack[3];
+	_transferOpened = true;
+	_transferAcknowledged = true;
+}
+
+
+
+// SyncRegisters -> Writes the dirty Spans of the Map to a Slave or Group; Spans of a failed Frame stay dirty
+template <class Config>
+bool gnMsup1Bus<Config>::syncRegisters(uint8_t address, gnMsup1RegisterMap& map, bool commitReceivedFlag) {
+	uint8_t records[Config::maxPayloadBuffer];
+	while (map.dirty()) {
+		uint8_t size = map.pack(records, Config::maxPayloadBuffer);
+		if (size == 0) {																																					// Payload-Buffer too small for a Record
+			return false;
+		}
+		if (!send(address, GNMSUP1_SYSTEMSERVICENUMBER, GNMSUP1_SYSTEMSERVICE_REGISTERWRITE, records, size, false, commitReceivedFlag, commitReceivedFlag)) {
+			uint8_t position = 0;
+			uint16_t offset;
+			const uint8_t* data;
+			uint8_t length;
+			while (gnMsup1RegisterMap::record(records, size, position, offset, data, length)) {
+				map.markDirty(offset, length);
+			}
+			return false;
+		}
+	}
+	return true;
+}
+
+
+
+// QueryCapabilities -> Asks a Slave for its Capabilities; the Answer goes to the Capabilities-Handler
+template <class Config>
+bool gnMsup1Bus<Config>::queryCapabilities(uint8_t address) {
+	if (!_ownsMasterRole() || !_initialized || address > Config::maxSlaveAddress || _baudActive ||				// A Payload-Buffer below the Answer can't receive it
+			Config::maxPayloadBuffer < GNMSUP1_CAPABILITIES_SIZE) {
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR: QUERYCAPABILITIES REJECTED (ROLE, ADDRESS, PAYLOAD-BUFFER OR BAUDRATE-SWITCH RUNNING)."));
+			}
+		#endif
+		return false;
+	}
+	
+	if (pushBlockingActive()) {																																	// Like send(): FullyAsynchronous fails, the other Modes wait
+		if (_blockingMode == FullyAsynchronous) {
+			return false;
+		}
+		_pushBlockingWaitForRelease();
+	}
+	
+	uint8_t empty[0];
+	return _sendFrame(address, GNMSUP1_SYSTEMSERVICENUMBER, GNMSUP1_SYSTEMSERVICE_CAPABILITIES, true, true, _blockingMode != FullyAsynchronous, false, false, empty, 0);
+}
+
+
+
+// StartBaudrateSwitch -> Starts moving the Bus to another Baudrate; handleCommunication advances the Steps
+template <class Config>
+bool gnMsup1Bus<Config>::startBaudrateSwitch(uint8_t beginAddress, uint8_t endAddress, uint32_t baudRate, BaudrateSwitchCallback completeHandler) {
+	if (!_ownsMasterRole() || !_initialized || _baudActive || _pollActive || _transferActive ||				// Master only, one Engine at a Time, valid Range, Rate of the own Transceiver
+			endAddress > Config::maxSlaveAddress || beginAddress > endAddress ||
+			Config::maxPayloadBuffer < GNMSUP1_CAPABILITIES_SIZE || !(baudrateMask(baudRate) & _supportedBaudrates)) {
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR: STARTBAUDRATESWITCH REJECTED (ROLE, ENGINE RUNNING, RANGE OR BAUDRATE)."));
+			}
+		#endif
+		return false;
+	}
+	
+	_baudActive = true;
+	_baudAwaiting = false;
+	_baudState = _BaudQuery;
+	_baudBeginAddress = beginAddress;
+	_baudEndAddress = endAddress;
+	_baudTarget = baudRate;
+	_baudFallbackRate = _baudrate;
+	_baudCompleteHandler = completeHandler;
+	_baudPresent.reset();
+	_baudNext(beginAddress);
+	return true;
+}
+
+
+
+// BaudService -> Advances the running Baudrate-Switch: evaluates the last Answer (or its Timeout) and sends the next Request
+template <class Config>
+void gnMsup1Bus<Config>::_baudService() {
+	if (!_baudActive || _pushBlocking.running(_timer) || _crPending || _baudSettle.running(_timer)) {
+		return;
+	}
+	
+	if (_baudState == _BaudFallback) {																													// Window passed: the Slaves are back at the old Rate, so is the Master
+		_setBaudrate(_baudFallbackRate);
+		_baudComplete(Err_BaudrateTimeout, _baudAddress);
+		return;
+	}
+	
+	if (_baudAwaiting) {																																				// Previous Request done
+		_baudAwaiting = false;
+		if (_baudState == _BaudQuery) {																														// Query: no Answer = absent, an Answer without the Rate rejects the Switch
+			if (_baudAnswered && !_baudCapable) {
+				_baudComplete(Err_BaudrateRejected, _baudAddress);
+				return;
+			}
+			if (_baudAnswered) {
+				_baudPresent.set(_baudAddress);
+			}
+			_baudNext(_baudAddress + 1);
+		} else if (_baudAnswered) {
+			_baudNext(_baudAddress + 1);
+		} else if (++_baudRetries > GNMSUP1_BAUDSWITCHRETRIES) {
+			if (_baudState == _BaudVerify) {																												// Dropped off at the new Rate: everybody falls back
+				_baudFallback();
+			} else {																																								// Commit lost: that Slave falls back alone
+				_baudComplete(Err_BaudrateTimeout, _baudAddress);
+			}
+			return;
+		} else {
+			_statisticsCount(_baudAddress, &Statistics::retries);
+		}
+	}
+	
+	if (_baudAddress == GNMSUP1_BROADCASTADDRESS) {																							// Step done
+		if (_baudState == _BaudQuery) {																														// Every present Slave can follow: broadcast the Switch, then verify at the new Rate
+			uint8_t command[GNMSUP1_BAUDSWITCH_SIZE];
+			command[0] = (uint8_t)(_baudTarget >> 24);
+			command[1] = (uint8_t)(_baudTarget >> 16);
+			command[2] = (uint8_t)(_baudTarget >> 8);
+			command[3] = (uint8_t)_baudTarget;
+			command[4] = highByte((uint16_t)GNMSUP1_BAUDSWITCHWINDOW);
+			command[5] = lowByte((uint16_t)GNMSUP1_BAUDSWITCHWINDOW);
+			for (uint8_t i = 0; i < GNMSUP1_BAUDSWITCHREPEAT; i++) {
+				_sendFrame(GNMSUP1_BROADCASTADDRESS, GNMSUP1_SYSTEMSERVICENUMBER, GNMSUP1_SYSTEMSERVICE_BAUDSWITCH, true, false, false, false, false, command, GNMSUP1_BAUDSWITCH_SIZE);
+			}
+			_baudWindow.arm(_timer, (uint32_t)GNMSUP1_BAUDSWITCHWINDOW * 1000);
+			if (!_setBaudrate(_baudTarget)) {																												// Own Transport refused the Rate
+				_baudAddress = GNMSUP1_MASTERPSEUDOADDRESS;
+				_baudFallback();
+				return;
+			}
+			_baudSettle.arm(_timer, (uint32_t)GNMSUP1_BAUDSWITCHSETTLE * 1000);
+			_baudState = _BaudVerify;
+			_baudNext(_baudBeginAddress);
+			return;
+		}
+		if (_baudState == _BaudVerify) {																													// Every Slave made it: confirm them, with at least half the Window left
+			if (_baudWindow.remaining(_timer) < (uint32_t)GNMSUP1_BAUDSWITCHWINDOW * 500) {
+				_baudAddress = GNMSUP1_MASTERPSEUDOADDRESS;
+				_baudFallback();
+				return;
+			}
+			_baudState = _BaudCommit;
+			_baudNext(_baudBeginAddress);
+		}
+		if (_baudAddress == GNMSUP1_BROADCASTADDRESS) {																						// Every Slave confirmed
+			_baudComplete(None, GNMSUP1_MASTERPSEUDOADDRESS);
+			return;
+		}
+	}
+	
+	uint8_t empty[0];
+	uint8_t subserviceNumber = (_baudState == _BaudQuery) ? GNMSUP1_SYSTEMSERVICE_CAPABILITIES :
+														 (_baudState == _BaudVerify) ? GNMSUP1_SYSTEMSERVICE_QUERYALIVE : GNMSUP1_SYSTEMSERVICE_BAUDCOMMIT;
+	_baudAnswered = false;
+	_baudCapable = false;
+	_baudAwaiting = true;
+	if (!_sendFrame(_baudAddress, GNMSUP1_SYSTEMSERVICENUMBER, subserviceNumber, true, true, false, false, false, empty, 0)) {
+		_pushBlockingRelease();																																		// Ignored Node: no Answer to wait for
+	}
+}
+
+
+
+// BaudNext -> Next Slave of the current Step from first on (Query: every not ignored one, later: every present one); Broadcast-Address when done
+template <class Config>
+void gnMsup1Bus<Config>::_baudNext(uint8_t first) {
+	_baudRetries = 0;
+	for (uint16_t address = first; address <= _baudEndAddress; address++) {
+		if (_baudState == _BaudQuery ? !_queryIgnore(address) : _baudPresent.test(address)) {
+			_baudAddress = address;
+			return;
+		}
+	}
+	_baudAddress = GNMSUP1_BROADCASTADDRESS;
+}
+
+
+
+// BaudFallback -> A Slave dropped off (or the Master can't switch): wait until the Window passed, the Slaves are back at the old Rate then
+template <class Config>
+void gnMsup1Bus<Config>::_baudFallback() {
+	_baudState = _BaudFallback;
+	_baudSettle.arm(_timer, _baudWindow.remaining(_timer) + (uint32_t)GNMSUP1_BAUDSWITCHSETTLE * 1000);
+}
+
+
+
+// BaudComplete -> Ends the Baudrate-Switch; a failure goes to the ErrorStore (Address of the failed Slave)
+template <class Config>
+void gnMsup1Bus<Config>::_baudComplete(ComErrorCode result, uint8_t address) {
+	_baudActive = false;
+	if (result != None) {
+		_lastComError.comErrorCode = result;
+		_lastComError.address = address;
+	}
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->print(result == None ? F("BAUDRATE-SWITCH COMPLETED") : F("ERR: BAUDRATE-SWITCH FAILED"));
+			_debugStream->print(F("\tBAUD:"));
+			_debugStream->println(_baudrate);
+		}
+	#endif
+	if (_baudCompleteHandler) {
+		_baudCompleteHandler(_baudrate, result);
+	}
+}
+
+
+
+// SetBaudrate -> Reconfigures the Transport and the Frame-Timeout; Bytes received at the old Rate get dropped
+template <class Config>
+bool gnMsup1Bus<Config>::_setBaudrate(uint32_t baudRate) {
+	_txService(true);																																						// The last Frame leaves at the old Rate
+	if (!_transport->begin(baudRate)) {
+		return false;
+	}
+	_baudrate = baudRate;
+	_frameTimeout = (baudRate == Config::defaultBaudrate) ? _defaultFrameTimeout : _frameTimeoutFor(baudRate);
+	_adaptiveBaudrate(baudRate);																																// Turnarounds learned at the old Rate don't apply
+	_decoder.reset();
+	_rxChunkPosition = _rxChunkLength;
+	return true;
+}
+
+
+
+// CapabilitiesAnswer -> Answers a Capability-Query (Slave); empty if the Payload-Buffer is too small for it
+template <class Config>
+void gnMsup1Bus<Config>::_capabilitiesAnswer(bool additionalPushMessagesFlag, bool commitReceivedFlag) {
+	uint8_t capabilities[GNMSUP1_CAPABILITIES_SIZE];
+	uint8_t features = 0;
+	if (_pushAggregation) {
+		features |= FeaturePushAggregation;
+	}
+	if (_registerMap) {
+		features |= FeatureRegisterMap;
+	}
+	if (_reassemblyBuffer || _reassemblySink) {
+		features |= FeatureTransferReceiver;
+	}
+	#ifdef GNMSUP1_STATISTICS
+		features |= FeatureStatistics;
+	#endif
+	
+	capabilities[0] = GNMSUP1_CAPABILITIES_VERSION;
+	capabilities[1] = Config::maxPayloadBuffer;
+	capabilities[2] = highByte((uint16_t)Config::maxPushQueueEntries);
+	capabilities[3] = lowByte((uint16_t)Config::maxPushQueueEntries);
+	capabilities[4] = features;
+	capabilities[5] = highByte(_supportedBaudrates);
+	capabilities[6] = lowByte(_supportedBaudrates);
+	_sendFrame(_address, GNMSUP1_SYSTEMSERVICENUMBER, GNMSUP1_SYSTEMSERVICE_CAPABILITIES, true, additionalPushMessagesFlag, false, commitReceivedFlag, false,
+						 capabilities, (Config::maxPayloadBuffer >= GNMSUP1_CAPABILITIES_SIZE) ? GNMSUP1_CAPABILITIES_SIZE : 0);
+}
+
+
+
+// CapabilitiesReceive -> Capabilities of a Slave (Master): feed the Switch-Engine and the Handler
+template <class Config>
+void gnMsup1Bus<Config>::_capabilitiesReceive(const uint8_t frame[]) {
+	if (frame[GNMSUP1_FRAMEBUF_PAYLOADSIZE] < GNMSUP1_CAPABILITIES_SIZE) {												// Slave without Room for the Answer: no Capabilities known
+		return;
+	}
+	
+	const uint8_t* payload = &frame[GNMSUP1_FRAMEBUF_PAYLOADSTART];
+	Capabilities capabilities;
+	capabilities.version = payload[0];
+	capabilities.maxPayloadBuffer = payload[1];
+	capabilities.maxPushQueueEntries = (payload[2] << 8) | payload[3];
+	capabilities.features = payload[4];
+	capabilities.baudrates = (payload[5] << 8) | payload[6];
+	
+	if (_baudActive && _baudAwaiting && frame[GNMSUP1_FRAMEBUF_ADDRESS] == _baudAddress) {
+		_baudCapable = capabilities.baudrates & baudrateMask(_baudTarget);
+	}
+	if (_capabilitiesHandler) {
+		_capabilitiesHandler(frame[GNMSUP1_FRAMEBUF_ADDRESS], capabilities);
+	}
+}
+
+
+
+// BaudSwitchReceive -> Switch-Command of the Master (Slave): follow if the Rate is supported, fall back unless confirmed within the Window
+template <class Config>
+void gnMsup1Bus<Config>::_baudSwitchReceive(const uint8_t frame[]) {
+	if (frame[GNMSUP1_FRAMEBUF_PAYLOADSIZE] < GNMSUP1_BAUDSWITCH_SIZE || _baudFallbackPending) {				// A Switch at a Time; Repeats of the Command come too late anyway
+		return;
+	}
+	
+	const uint8_t* command = &frame[GNMSUP1_FRAMEBUF_PAYLOADSTART];
+	uint32_t baudRate = ((uint32_t)command[0] << 24) | ((uint32_t)command[1] << 16) | ((uint32_t)command[2] << 8) | command[3];
+	uint16_t window = (command[4] << 8) | command[5];
+	uint32_t previous = _baudrate;
+	if (!(baudrateMask(baudRate) & _supportedBaudrates) || !_setBaudrate(baudRate)) {
+		return;
+	}
+	
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->print(F("BAUDRATE SWITCHED TO "));
+			_debugStream->println(baudRate);
+		}
+	#endif
+	_baudFallbackRate = previous;
+	_baudFallbackPending = true;
+	_baudWindow.arm(_timer, (uint32_t)window * 1000);
+}
+
+
+
+// JoinGroup -> Slave accepts Frames to the Multicast-Group (Address GNMSUP1_GROUPADDRESS(group))
+template <class Config>
+bool gnMsup1Bus<Config>::joinGroup(uint8_t group) {
+	if (_ownsMasterRole() || group >= GNMSUP1_GROUPCOUNT) {
+		return false;
+	}
+	bitSet(_groupMask, group);
+	return true;
+}
+
+
+
+// LeaveGroup -> Slave stops accepting Frames to the Multicast-Group
+template <class Config>
+bool gnMsup1Bus<Config>::leaveGroup(uint8_t group) {
+	if (_ownsMasterRole() || group >= GNMSUP1_GROUPCOUNT) {
+		return false;
+	}
+	bitClear(_groupMask, group);
+	return true;
+}
+
+
+
+// GetLastComError - Provides additional Information about the Error occurred (and reset the ErrorStore)
+template <class Config>
+gnMsup1Base::comError_t gnMsup1Bus<Config>::getLastComError() {
+	comError_t last = _lastComError;
+	comError_t empty;
+	_lastComError = empty;
+	return last;
+}
+
+
+
+#ifdef GNMSUP1_STATISTICS
+// Statistics -> Copies the Counters of a Slave-Address
+template <class Config>
+bool gnMsup1Bus<Config>::statistics(uint8_t address, Statistics& snapshot) {
+	if (address > Config::maxSlaveAddress) {
+		return false;
+	}
+	snapshot = _statisticsStore[address];
+	return true;
+}
+#endif
+
+
+
+// StatisticsCount -> Increments a Counter of a Slave-Address (invalid Addresses, e.g. Broadcast, are not counted)
+template <class Config>
+void gnMsup1Bus<Config>::_statisticsCount(uint8_t address, uint32_t Statistics::* counter) {
+	#ifdef GNMSUP1_STATISTICS
+		if (address <= Config::maxSlaveAddress) {
+			_statisticsStore[address].*counter += 1;
+		}
+	#endif
+}
+
+
+
+// StatisticsLatency -> Sorts the Time since startMicros into a Histogram-Bucket of a Slave-Address
+template <class Config>
+void gnMsup1Bus<Config>::_statisticsLatency(uint8_t address, uint32_t (Statistics::* histogram)[GNMSUP1_STATISTICSBUCKETS], uint32_t startMicros) {
+	#ifdef GNMSUP1_STATISTICS
+		if (address <= Config::maxSlaveAddress) {
+			uint32_t elapsed = (_timer.micros() - startMicros) / GNMSUP1_STATISTICSBUCKETMICROS;
+			uint8_t bucket = 0;
+			while (elapsed > 0 && bucket < GNMSUP1_STATISTICSBUCKETS - 1) {																	// Bucket n: below Limit << n
+				elapsed >>= 1;
+				bucket++;
+			}
+			(_statisticsStore[address].*histogram)[bucket]++;
+		}
+	#endif
+}
+
+
+
+// ResetTimeouts -> Forgets the learned Timeouts of every Slave; the fixed ones apply until new Samples arrive
+template <class Config>
+void gnMsup1Bus<Config>::resetTimeouts() {
+	#ifdef GNMSUP1_ADAPTIVETIMEOUTS
+		for (uint8_t address = 0; address <= Config::maxSlaveAddress; address++) {
+			_adaptiveStore[address].push.reset();
+			_adaptiveStore[address].cr.reset();
+			_adaptiveStore[address].frame.reset();
+		}
+		_adaptivePushOpen = false;
+	#endif
+}
+
+
+
+// PushBlockingSet -> Arms the Push-Blocking for a Push-Request of frameBytes to a Slave; the previous Request still open means it timed out
+template <class Config>
+void gnMsup1Bus<Config>::_pushBlockingSet(uint8_t address, uint16_t frameBytes) {
+	#ifdef GNMSUP1_ADAPTIVETIMEOUTS
+		if (_adaptivePushOpen && !_crPending && _adaptivePushAddress <= Config::maxSlaveAddress) {				// A Resend of a CR-Retry is no Timeout
+			_adaptiveStore[_adaptivePushAddress].push.backoff();
+		}
+		_adaptivePushOpen = true;
+		_adaptivePushAddress = address;
+		_adaptivePushBytes = frameBytes;
+	#endif
+	_pushBlocking.arm(_timer, _pushTimeoutFor(address, frameBytes));
+}
+
+
+
+// PushTimeoutFor -> Request on the Line + learned Turnaround + longest Answer; the fixed Push-Timeout at most
+template <class Config>
+uint32_t gnMsup1Bus<Config>::_pushTimeoutFor(uint8_t address, uint16_t frameBytes) {
+	#ifdef GNMSUP1_ADAPTIVETIMEOUTS
+		if (address <= Config::maxSlaveAddress && _adaptiveStore[address].push.learned()) {
+			uint32_t timeout = _airtime(frameBytes + GNMSUP1_FRAMEOVERHEAD + 5 + Config::maxPayloadBuffer) +
+												 _adaptiveStore[address].push.timeout(GNMSUP1_ADAPTIVEFLOORMICROS, _pushTimeoutMicros);
+			return (timeout < _pushTimeoutMicros) ? timeout : _pushTimeoutMicros;
+		}
+	#endif
+	return _pushTimeoutMicros;
+}
+
+
+
+// CrTimeoutFor -> Learned Turnaround + CRC16-Echo on the Line; 40% of the Frame-Timeout at most
+template <class Config>
+uint32_t gnMsup1Bus<Config>::_crTimeoutFor(uint8_t address) {
+	uint32_t ceiling = _frameTimeout * 4 / 10;
+	#ifdef GNMSUP1_ADAPTIVETIMEOUTS
+		if (address <= Config::maxSlaveAddress && _adaptiveStore[address].cr.learned()) {
+			uint32_t timeout = _airtime(2) + _adaptiveStore[address].cr.timeout(GNMSUP1_ADAPTIVEFLOORMICROS, ceiling);
+			return (timeout < ceiling) ? timeout : ceiling;
+		}
+	#endif
+	return ceiling;
+}
+
+
+
+// RxFrameTimeout -> Frame-Timeout for the Frame on the Line: the Master expects it from the Slave it asked last
+template <class Config>
+uint32_t gnMsup1Bus<Config>::_rxFrameTimeout() {
+	#ifdef GNMSUP1_ADAPTIVETIMEOUTS
+		if (_ownsMasterRole() && _adaptivePushAddress <= Config::maxSlaveAddress && _adaptiveStore[_adaptivePushAddress].frame.learned()) {
+			uint32_t timeout = _airtime(GNMSUP1_FRAMEOVERHEAD + 5 + Config::maxPayloadBuffer) +
+												 _adaptiveStore[_adaptivePushAddress].frame.timeout(GNMSUP1_ADAPTIVEFLOORMICROS, _frameTimeout);
+			return (timeout < _frameTimeout) ? timeout : _frameTimeout;
+		}
+	#endif
+	return _frameTimeout;
+}
+
+
+
+// AdaptiveBaudrate -> Time per Byte for the Airtime of the Estimates; forgets the learned Values
+template <class Config>
+void gnMsup1Bus<Config>::_adaptiveBaudrate(uint32_t baudRate) {
+	_byteTime16 = 160000000ul / baudRate;
+	#ifdef GNMSUP1_ADAPTIVETIMEOUTS
+		resetTimeouts();
+	#endif
+}
+
+
+
+// AdaptivePushAnswer -> Answer of a Slave (Master): its Turnaround is a Sample, unless it came too late (Backoff)
+template <class Config>
+void gnMsup1Bus<Config>::_adaptivePushAnswer(uint8_t address, uint32_t startMicros) {
+	#ifdef GNMSUP1_ADAPTIVETIMEOUTS
+		if (!_adaptivePushOpen || address != _adaptivePushAddress || address > Config::maxSlaveAddress) {
+			return;
+		}
+		_adaptivePushOpen = false;
+		if (!_pushBlocking.running(_timer)) {
+			_adaptiveStore[address].push.backoff();
+			return;
+		}
+		uint32_t turnaround = startMicros - _pushBlocking.start();
+		uint32_t request = _airtime(_adaptivePushBytes);
+		_adaptiveStore[address].push.sample(turnaround > request ? turnaround - request : 0);
+	#endif
+}
+
+
+
+// AdaptiveCr -> CRC16-Echo received (Sample) or timed out (Backoff); a mismatching Echo says nothing about the Timing
+template <class Config>
+void gnMsup1Bus<Config>::_adaptiveCr(ComErrorCode result) {
+	#ifdef GNMSUP1_ADAPTIVETIMEOUTS
+		if (!_ownsMasterRole() || _crAddress > Config::maxSlaveAddress) {
+			return;
+		}
+		if (result == Err_CRTimeout) {
+			_adaptiveStore[_crAddress].cr.backoff();
+		} else if (result == None) {
+			uint32_t turnaround = _timer.micros() - _crDeadline.start();																// Armed after the Flush: the Request's Time on the Line is not in it
+			uint32_t echo = _airtime(2);
+			_adaptiveStore[_crAddress].cr.sample(turnaround > echo ? turnaround - echo : 0);
+		}
+	#endif
+}
+
+
+
+// AdaptiveFrame -> Frame of the Slave asked last (Master): the Time beyond its Airtime is a Sample of its Gaps
+template <class Config>
+void gnMsup1Bus<Config>::_adaptiveFrame(const uint8_t frame[], uint32_t startMicros) {
+	#ifdef GNMSUP1_ADAPTIVETIMEOUTS
+		if (!_ownsMasterRole() || frame[GNMSUP1_FRAMEBUF_ADDRESS] != _adaptivePushAddress || _adaptivePushAddress > Config::maxSlaveAddress) {
+			return;
+		}
+		uint16_t bytes = GNMSUP1_FRAMEOVERHEAD - 2 + (bitRead(frame[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_SERVICE) ?		// Measured from StartByte 2 on
+										 5 + frame[GNMSUP1_FRAMEBUF_PAYLOADSIZE] : 2);
+		uint32_t duration = _timer.micros() - startMicros;
+		uint32_t airtime = _airtime(bytes);
+		_adaptiveStore[_adaptivePushAddress].frame.sample(duration > airtime ? duration - airtime : 0);
+	#endif
+}
+
+
+
+// AdaptiveFrameDrop -> Frame-Timeout (Master): the Gaps of the Slave asked last got longer
+template <class Config>
+void gnMsup1Bus<Config>::_adaptiveFrameDrop() {
+	#ifdef GNMSUP1_ADAPTIVETIMEOUTS
+		if (_ownsMasterRole() && _adaptivePushAddress <= Config::maxSlaveAddress) {
+			_adaptiveStore[_adaptivePushAddress].frame.backoff();
+		}
+	#endif
+}
+
+
+
+// AttachSerialDebug - Allows to output some Debug-Informations to a Serial Port (SoftwareSerial or HardwareSerial); only works if GNMSUP1_DEBUG defined
+#ifdef GNMSUP1_PLATFORM_ARDUINO
+template <class Config>
+void gnMsup1Bus<Config>::attachSerialDebug(HardwareSerial& device) {
+	#ifdef GNMSUP1_DEBUG
+		_hwDebugStream = &device;
+		_debugStream = (Stream*)_hwDebugStream;
+		_debugAttached = true;
+	#endif
+}
+
+template <class Config>
+void gnMsup1Bus<Config>::attachSerialDebug(SoftwareSerial& device) {
+	#ifdef GNMSUP1_DEBUG
+		_swDebugStream = &device;
+		_debugStream = (Stream*)_swDebugStream;
+		_debugAttached = true;
+	#endif
+}
+#endif
+
+
+
+// Private ///////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+// LookupService -> Returns the Callback attached to the ServiceNumber; nullptr if none
+template <class Config>
+gnMsup1Base::ServiceHandlerCallback gnMsup1Bus<Config>::_lookupService(uint8_t serviceNumber) {
+	#ifdef GNMSUP1_DIRECTSERVICETABLE																														// Direct Table: one Index Operation
+		if (_serviceTable[serviceNumber]) {
+			return _serviceTable[serviceNumber];
+		}
+	#else																																												// Hash-Table: Home-Slot, probe until a free Slot
+		uint8_t slot = serviceNumber & (_serviceSlotCount - 1);
+		while (_serviceSlots[slot].serviceHandler) {
+			if (_serviceSlots[slot].serviceNumber == serviceNumber) {
+				return _serviceSlots[slot].serviceHandler;
+			}
+			slot = (slot + 1) & (_serviceSlotCount - 1);
+		}
+	#endif
+	
+	uint8_t low = 0;																																						// Compile-time Table: binary Search
+	uint8_t high = _serviceStaticCount;
+	while (low < high) {
+		uint8_t middle = (low + high) / 2;
+		ServiceEntry entry;
+		gnMsup1MemcpyFlash(&entry, &_serviceStaticTable[middle], sizeof(entry));
+		if (entry.serviceNumber == serviceNumber) {
+			return entry.serviceHandler;
+		} else if (entry.serviceNumber < serviceNumber) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return nullptr;
+}
+
+
+
+// ReadInput -> Drains the Input chunk-wise into the Frame-Decoder (as long as the Input-Buffer provides Bytes); Returns True, if a complete (& valid) Frame is in the Buffer
+template <class Config>
+bool gnMsup1Bus<Config>::_readInput() {
+	if (_rxBufferBusy == 0x03) {																																// Both Receive-Buffers hold Frames in Processing (nested Callbacks); leave the Bytes in the Transport
+		return false;
+	}
+	
+	if (_decoder.inFrame() && _timer.micros() - _decoder.startTime() > _rxFrameTimeout()) {					// Reset the Decoder if Timeout exceeded (this will cause a frame-drop)
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("\tDROP:TIMEOUT"));
+			}
+		#endif
+		
+		_adaptiveFrameDrop();
+		_decoder.drop(gnMsup1FrameDecoder::DropTimeout);
+	}
+	
+	while (true) {
+		if (_rxChunkPosition == _rxChunkLength) {																									// Chunk used up: drain the next one from the Transport
+			_rxChunkPosition = 0;
+			_rxChunkLength = _transport->read(_rxChunk, sizeof(_rxChunk));
+			if (_rxChunkLength == 0) {
+				_decoder.idle(_timer.micros());																												// Drained: the Idle-Gap can count from here
+				return false;
+			}
+			
+			#ifdef GNMSUP1_DEBUG
+				if (_debugAttached) {
+					_debugStream->print(F(">"));
+					for (uint8_t i = 0; i < _rxChunkLength; i++) {
+						_debugStream->print(F(" 0x"));
+						_debugPrintHex(_rxChunk[i]);
+					}
+					_debugStream->println();
+				}
+			#endif
+		}
+		
+		_rxChunkPosition += _decoder.feed(&_rxChunk[_rxChunkPosition], _rxChunkLength - _rxChunkPosition, _timer.micros());
+		
+		if (_decoder.event() == gnMsup1FrameDecoder::EventFrame) {																// Frame complete: check CRC, Address and Direction
+			_frameStartTime = _decoder.startTime();
+			_rxFrame = _decoder.buffer();
+			
+			#ifdef GNMSUP1_DEBUG
+				if (_debugAttached) {
+					_debugStream->print(F("FRAME\tDIR:"));
+					_debugStream->print(bitRead(_rxFrame[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_DIRECTION), BIN);
+					_debugStream->print(F(", SERVICE:"));
+					_debugStream->print(bitRead(_rxFrame[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_SERVICE), BIN);
+					_debugStream->print(F(", PUSH:"));
+					_debugStream->print(bitRead(_rxFrame[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_PUSH), BIN);
+					_debugStream->print(F(", CR:"));
+					_debugStream->print(bitRead(_rxFrame[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_COMMITRECEIVE), BIN);
+					_debugStream->print(F("\tADDR:0x"));
+					_debugPrintHex(_rxFrame[GNMSUP1_FRAMEBUF_ADDRESS]);
+				}
+			#endif
+			
+			if (_validateFrame()) {
+				_adaptiveFrame(_rxFrame, _frameStartTime);
+				_statisticsCount(_ownsMasterRole() ? _rxFrame[GNMSUP1_FRAMEBUF_ADDRESS] : _address, &Statistics::framesReceived);
+				return true;
+			}
+			_decoder.reset();
+		}
+		
+		#ifdef GNMSUP1_DEBUG
+			if (_decoder.event() == gnMsup1FrameDecoder::EventDrop && _debugAttached) {
+				_debugStream->print(F("\tDROP:"));
+				switch (_decoder.dropReason()) {
+					case gnMsup1FrameDecoder::DropStart2:
+						_debugStream->println(F("OUTOFORDER_START2"));
+						break;
+					case gnMsup1FrameDecoder::DropOversize:
+						_debugStream->println(F("PAYLOAD EXCEEDS BUFFER"));
+						break;
+					case gnMsup1FrameDecoder::DropStop1:
+						_debugStream->println(F("OUTOFORDER_STOP1"));
+						break;
+					case gnMsup1FrameDecoder::DropIdleGap:
+						_debugStream->println(F("IDLEGAP"));
+						break;
+					default:
+						_debugStream->println(F("OUTOFORDER_STOP2"));
+				}
+			}
+		#endif
+	}
+}
+
+
+
+// ProcessFrame -> Processes a incoming Frame and delegate it to the Callback or System-Service
+template <class Config>
+void gnMsup1Bus<Config>::_processFrame() {
+	const uint8_t* frame = _rxFrame;																														// Lock the Receive-Buffer of this Frame; the Decoder continues in the other one (if free)
+	uint8_t frameSlot = (frame == _rxBuffer[0]) ? 0 : 1;
+	bitSet(_rxBufferBusy, frameSlot);
+	if (!bitRead(_rxBufferBusy, frameSlot ^ 1)) {
+		_decoder.setBuffer(_rxBuffer[frameSlot ^ 1]);
+	}
+	uint32_t frameStartTime = _frameStartTime;
+	
+	#ifdef GNMSUP1_STATISTICS
+		if (_ownsMasterRole() && _pushBlocking.running(_timer) && frame[GNMSUP1_FRAMEBUF_ADDRESS] == _statisticsPushAddress) {	// Answer of the outstanding Push-Request
+			_statisticsLatency(_statisticsPushAddress, &Statistics::pushTurnaround, _statisticsPushMicros);
+		}
+	#endif
+	if (_ownsMasterRole()) {																																		// Turnaround of the Slave (before the Push-Blocking gets released)
+		_adaptivePushAnswer(frame[GNMSUP1_FRAMEBUF_ADDRESS], frameStartTime);
+	}
+	
+	bool pushFlag = bitRead(frame[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_PUSH);							// Store the Push-Flag for use after Callback
+	bool groupFrame = !_ownsMasterRole() && _isGroupAddress(frame[GNMSUP1_FRAMEBUF_ADDRESS]);
+	if (groupFrame) {																																						// Group-Frames get no Answer: no Push-Clearance, no System-Service
+		pushFlag = false;
+	}
+	bool additionalPushMessagesFlag;
+	uint8_t empty[0];
+	
+	if (bitRead(frame[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_SERVICE)) {											// Only call a Service if ServiceFlag is set
+		if (frame[GNMSUP1_FRAMEBUF_SERVICE] == GNMSUP1_SYSTEMSERVICENUMBER) {											// Checks for System-Service
+			if (!groupFrame || frame[GNMSUP1_FRAMEBUF_SUBSERVICE] == GNMSUP1_SYSTEMSERVICE_REGISTERWRITE ||	// Register-Writes and Baudrate-Switches don't answer, so they work for Groups
+					frame[GNMSUP1_FRAMEBUF_SUBSERVICE] == GNMSUP1_SYSTEMSERVICE_BAUDSWITCH) {
+				pushFlag = _handleSystemService(frame, pushFlag);																			// Handle the System-Service, set Push-Flag dependent of the type
+			}
+		} else {
+			_dispatchService(frame[GNMSUP1_FRAMEBUF_SERVICE], frame[GNMSUP1_FRAMEBUF_SUBSERVICE],				// Invoke Callback-Function with a View into the Receive-Buffer
+											 &frame[GNMSUP1_FRAMEBUF_PAYLOADSTART], frame[GNMSUP1_FRAMEBUF_PAYLOADSIZE], frame[GNMSUP1_FRAMEBUF_ADDRESS]);
+		}
+	}
+	
+	bitClear(_rxBufferBusy, frameSlot);																													// Release the Receive-Buffer after processing the Frame
+	if (_ownsMasterRole()) {																																		// Master: Release the PushBlocking and set _additionalPushMsgAvailable Flag
+		if (_baudAwaiting && frame[GNMSUP1_FRAMEBUF_ADDRESS] == _baudAddress) {
+			_baudAnswered = true;
+		}
+		_pushBlockingRelease();
+		_additionalPushMsgAvailable = pushFlag;
+	} else if (pushFlag) {																																			// Check if Slave got push-clearance (as a Slave)
+		_timer.refresh();																																					// After the Callbacks
+		if (_timer.micros() - frameStartTime <= _pushTimeoutMicros) {																// Assure there was no Timeout (during Callback-Function)
+			_pushStore_t* pushStoreEntry = _pushStoreFront();
+			if (pushStoreEntry) {																																		// Check for PushMessages in Store and send if available (the most urgent first)
+				PushIndex pushStoreSlots[Config::maxPayloadBuffer / GNMSUP1_AGGREGATE_RECORDHEADER + 1];		// Sent Entries: Slot and Ticket
+				uint16_t pushStoreTickets[Config::maxPayloadBuffer / GNMSUP1_AGGREGATE_RECORDHEADER + 1];
+				uint16_t pushStorePacked = 1;
+				pushStoreSlots[0] = pushStoreEntry - _pushStore;
+				pushStoreTickets[0] = pushStoreEntry->ticket;
+				bool pushCommitReceive = bitRead(pushStoreEntry->flags, GNMSUP1_PUSHBUFFLAG_COMMITRECEIVE);
+				uint8_t aggregate[Config::maxPayloadBuffer];
+				uint16_t aggregateSize = 0;
+				if (_pushAggregation) {																																	// Aggregation: pack as many Entries as fit into one Frame (Records: Service, Subservice, Size, Payload)
+					pushStorePacked = 0;
+					bool full = false;
+					for (int8_t priority = GNMSUP1_PUSHPRIORITIES - 1; priority >= 0 && !full; priority--) {					// In the Order of the Hand-Out: Class by Class, oldest first
+						PushIndex slot = _pushClassHead[priority];
+						for (PushIndex i = 0; i < _pushClassCount[priority]; i++, slot = _pushStore[slot].next) {
+							_pushStore_t* entry = &_pushStore[slot];
+							if (aggregateSize + GNMSUP1_AGGREGATE_RECORDHEADER + entry->payloadSize > Config::maxPayloadBuffer) {
+								full = true;
+								break;
+							}
+							aggregate[aggregateSize++] = entry->serviceNumber;
+							aggregate[aggregateSize++] = entry->subserviceNumber;
+							aggregate[aggregateSize++] = entry->payloadSize;
+							memcpy(&aggregate[aggregateSize], entry->payload, entry->payloadSize);
+							aggregateSize += entry->payloadSize;
+							pushCommitReceive |= bitRead(entry->flags, GNMSUP1_PUSHBUFFLAG_COMMITRECEIVE);
+							pushStoreSlots[pushStorePacked] = slot;
+							pushStoreTickets[pushStorePacked] = entry->ticket;
+							pushStorePacked++;
+						}
+					}
+					if (pushStorePacked < 2) {																														// Nothing gained (or the first doesn't fit): send it plain
+						pushStorePacked = 1;
+						pushStoreSlots[0] = pushStoreEntry - _pushStore;
+						pushStoreTickets[0] = pushStoreEntry->ticket;
+						pushCommitReceive = bitRead(pushStoreEntry->flags, GNMSUP1_PUSHBUFFLAG_COMMITRECEIVE);
+					}
+				}
+				additionalPushMessagesFlag = (_pushStoreCount > pushStorePacked) || _registerPending();			// Calculate after Callback
+				
+				#ifdef GNMSUP1_DEBUG
+					if (_debugAttached) {
+						_debugStream->print(F("PUSH-CLEARANCE RECEIVED: SEND "));
+						_debugStream->print(pushStorePacked);
+						_debugStream->print(F(" PENDING MESSAGE(S), "));
+						if (additionalPushMessagesFlag) {
+							_debugStream->println(F("MORE IN QEUE."));
+						} else {
+							_debugStream->println(F("LAST IN QEUE."));
+						}
+						_debugStream->println();
+					}
+				#endif
+				
+				bool sent;
+				if (pushStorePacked > 1) {
+					sent = _sendFrame(_address, GNMSUP1_SYSTEMSERVICENUMBER, GNMSUP1_SYSTEMSERVICE_AGGREGATE, true,
+														additionalPushMessagesFlag, false, pushCommitReceive, false, aggregate, aggregateSize);
+				} else {
+					sent = _sendFrame(_address, pushStoreEntry->serviceNumber, pushStoreEntry->subserviceNumber, true,
+														additionalPushMessagesFlag, false, pushCommitReceive, false, pushStoreEntry->payload, pushStoreEntry->payloadSize);
+				}
+				if (!sent && pushCommitReceive) {																											// If NOT succeeded and CommitReceive-Flag set, keep the Entries in the Store
+					#ifdef GNMSUP1_DEBUG
+						if (_debugAttached) {
+							_debugStream->println(F("ERR: REQUEUE MESSAGE DUE TO COMMITRECEIVE ERROR."));
+						}
+					#endif
+				} else {																																							// Mark the Messages as completed (unless they expired meanwhile)
+					for (uint16_t i = 0; i < pushStorePacked; i++) {
+						if (_pushStoreQueued(pushStoreSlots[i], pushStoreTickets[i])) {
+							_pushStoreRemove(pushStoreSlots[i]);
+						}
+					}
+				}
+				
+			} else if (_registerPending()) {																												// No Messages queued: push the dirty Registers (Delta)
+				uint8_t records[Config::maxPayloadBuffer];
+				uint8_t size = _registerMap->pack(records, Config::maxPayloadBuffer);
+				if (!_sendFrame(_address, GNMSUP1_SYSTEMSERVICENUMBER, GNMSUP1_SYSTEMSERVICE_REGISTERDELTA, true,
+												_registerPending(), false, _registerCommitReceive, false, records, size)) {
+					uint8_t position = 0;																																// CR failed: the Spans stay dirty
+					uint16_t offset;
+					const uint8_t* data;
+					uint8_t length;
+					while (gnMsup1RegisterMap::record(records, size, position, offset, data, length)) {
+						_registerMap->markDirty(offset, length);
+					}
+				}
+				
+			} else {																																								// Let the master know, that we don't have any PushMessages for him
+				#ifdef GNMSUP1_DEBUG
+					if (_debugAttached) {
+						_debugStream->println(F("NO PUSH MESSAGES, INFORM MASTER"));
+					}
+				#endif
+				
+				_sendFrame(_address, 0, 0, false, false, false, false, false, empty, 0);
+			}
+		} else {																																									// Timeout - not able to answer the Push-Request
+			#ifdef GNMSUP1_DEBUG
+				if (_debugAttached) {
+					_debugStream->println(F("WRN:TIMEOUT UNABLE TO ANSWER PUSH-REQUEST IN TIME. AVOID THIS CONDITION!"));
+				}
+			#endif
+		}
+	}
+}
+
+
+
+// DispatchService -> Invokes the Callback of a Service (or the CatchAll); counts the Messages of a polled Slave (Master)
+template <class Config>
+void gnMsup1Bus<Config>::_dispatchService(uint8_t serviceNumber, uint8_t subserviceNumber, const uint8_t payload[], uint8_t payloadSize, uint8_t sourceAddress) {
+	if (_ownsMasterRole() && _pollAwaiting && sourceAddress == _pollAddress) {
+		_pollMessages++;
+	}
+	
+	ServiceHandlerCallback serviceHandler = _lookupService(serviceNumber);
+	if (!serviceHandler && !_callbackCatchAllActive) {																					// Check if Service or CatchAll is attached
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->print(F("ERR:SERVICE 0x"));
+				_debugPrintHex(serviceNumber);
+				_debugStream->println(F(": NOT ATTACHED"));
+				_debugStream->println();
+			}
+		#endif
+	} else {																																										// Invoke Callback-Function
+		if (!serviceHandler) {
+			#ifdef GNMSUP1_DEBUG
+				if (_debugAttached) {
+					_debugStream->println(F("INVOKE CATCHALL-CALLBACK"));
+				}
+			#endif
+			
+			_callbackCatchAllHandler(serviceNumber, subserviceNumber, payload, payloadSize, sourceAddress);
+		} else {
+			#ifdef GNMSUP1_DEBUG
+				if (_debugAttached) {
+					_debugStream->println(F("INVOKE SERVICE-CALLBACK"));
+				}
+			#endif
+			
+			serviceHandler(subserviceNumber, payload, payloadSize, sourceAddress);
+		}
+		
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("CALLBACK FINISHED"));
+				_debugStream->println();
+			}
+		#endif
+	}
+}
+
+
+
+// ValidateFrame -> Returns true if Frame is addressed to myself and has a valid Checksum; Handles also the CommitReceive Flag
+template <class Config>
+bool gnMsup1Bus<Config>::_validateFrame() {
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->println();
+		}
+	#endif
+	
+	uint16_t frameChecksum = _decoder.checksum();
+	if (!_decoder.checksumValid()) {																														// CRC16 Validation (computed by the Decoder while receiving)
+		_statisticsCount(_rxFrame[GNMSUP1_FRAMEBUF_ADDRESS], &Statistics::crcFailures);						// Best Guess: the Address-Byte may be the broken one
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("DROP:INVALID CHECKSUM"));
+			}
+		#endif
+		
+		return false;
+	}
+	
+	_markActive(_rxFrame[GNMSUP1_FRAMEBUF_ADDRESS]);																				// Mark Address as active
+	
+	if (!_ownsMasterRole() &&																																		// Address Filter (own Address, Broadcast or joined Group)
+			!_acceptsAddress(_rxFrame[GNMSUP1_FRAMEBUF_ADDRESS])) {
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("DROP:NOT FOR ME"));
+			}
+		#endif
+		
+		return false;
+	}
+	
+	if (!_ownsMasterRole() &&																																		// Direction Filter
+			bitRead(_rxFrame[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_DIRECTION)) {
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR:DUPLICATE ADDRESS DETECTED"));
+			}
+		#endif
+		
+		return false;				
+	}
+	
+	if (bitRead(_rxFrame[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_COMMITRECEIVE) &&						// CommitReceive handler; never for Group-Frames (every Slave would answer)
+			!_isGroupAddress(_rxFrame[GNMSUP1_FRAMEBUF_ADDRESS])) {
+		_txService(true);
+		_transport->setDriverEnable(true);																												// Set DE for RS485; delay Debug-Output because its time-sensitive
+		
+		uint8_t crBuffer[2] = {highByte(frameChecksum), lowByte(frameChecksum)};								// Write-Out CRC16
+		_transport->write(crBuffer, 2);
+		_txStart(_ownsMasterRole() ? _rxFrame[GNMSUP1_FRAMEBUF_ADDRESS] : GNMSUP1_MASTERPSEUDOADDRESS, !_txAsync);	// Release DE when written-Out
+		
+		#ifdef GNMSUP1_DEBUG																																			// Now write all Debug-Informations
+			if (_debugAttached) {
+				_debugStream->println(F("<RS485 DE-PIN SET"));
+				_debugStream->print(F("<0x00\t0x"));
+				_debugPrintHex(highByte(frameChecksum));
+				_debugStream->println(F("\tCOMMITRECEIVE"));
+				_debugStream->print(F("<0x01\t0x"));
+				_debugPrintHex(lowByte(frameChecksum));
+				_debugStream->println();
+			}
+		#endif
+	}
+	
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->println(F("FRAME:VALID"));
+		}
+	#endif
+				
+	return true;
+}
+
+
+
+// HandleSystemService -> Process a System-Service Frame
+template <class Config>
+bool gnMsup1Bus<Config>::_handleSystemService(const uint8_t frame[], bool pushFlag) {
+	bool pushAnswerCommitReceiveFlag = bitRead(frame[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_COMMITRECEIVE);	// Evaluate the CommitReceive-Flag
+	uint8_t empty[0];
+	
+	if (_ownsMasterRole()) {																																		// Role specific implementations
+		switch (frame[GNMSUP1_FRAMEBUF_SUBSERVICE]) {
+			case GNMSUP1_SYSTEMSERVICE_AGGREGATE:																										// Aggregated Push-Messages: dispatch every Record
+				{
+					const uint8_t* record = &frame[GNMSUP1_FRAMEBUF_PAYLOADSTART];
+					const uint8_t* recordsEnd = record + frame[GNMSUP1_FRAMEBUF_PAYLOADSIZE];
+					while (record + GNMSUP1_AGGREGATE_RECORDHEADER <= recordsEnd &&
+								 record + GNMSUP1_AGGREGATE_RECORDHEADER + record[2] <= recordsEnd) {
+						_dispatchService(record[0], record[1], &record[GNMSUP1_AGGREGATE_RECORDHEADER], record[2], frame[GNMSUP1_FRAMEBUF_ADDRESS]);
+						record += GNMSUP1_AGGREGATE_RECORDHEADER + record[2];
+					}
+				}
+				return pushFlag;
+				
+			case GNMSUP1_SYSTEMSERVICE_REGISTERDELTA:																								// Delta of a Register-Map: one Callback per Span
+				if (_pollAwaiting && frame[GNMSUP1_FRAMEBUF_ADDRESS] == _pollAddress) {
+					_pollMessages++;
+				}
+				_registerDispatch(frame);
+				return pushFlag;
+				
+			case GNMSUP1_SYSTEMSERVICE_SEGMENTACK:																									// Ack of a Segmented Transfer
+				_transferAcknowledge(frame);
+				return pushFlag;
+				
+			case GNMSUP1_SYSTEMSERVICE_CAPABILITIES:																								// Capabilities of a Slave
+				_capabilitiesReceive(frame);
+				return pushFlag;
+				
+			case GNMSUP1_SYSTEMSERVICE_IGNORE:																											// Ignore-Service (ignore :-)
+				#ifdef GNMSUP1_DEBUG
+					if (_debugAttached) {
+						_debugStream->println(F("GOT A IGNORE-PACKET"));
+					}
+				#endif
+				return pushFlag;
+				
+			default:																																								// Not implemented
+				#ifdef GNMSUP1_DEBUG
+					if (_debugAttached) {
+						_debugStream->print(F("ERR:SYSTEM-SERVICE 0x"));
+						_debugPrintHex(frame[GNMSUP1_FRAMEBUF_SUBSERVICE]);
+						_debugStream->println(F(": NOT IMPLEMENTED ON MASTER"));
+						_debugStream->println();
+					}
+				#endif
+				return pushFlag;
+		}
+	} else {																																										// Slave Role, processing System-Service...
+		bool additionalPushMessagesFlag = (_pushStoreFront() != NULL) || _registerPending();								// Calculate the PushFlag
+		
+		switch (frame[GNMSUP1_FRAMEBUF_SUBSERVICE]) {
+			case GNMSUP1_SYSTEMSERVICE_QUERYALIVE:																									// QueryAlive, send Answer
+				#ifdef GNMSUP1_DEBUG
+					if (_debugAttached) {
+						_debugStream->println(F("ASKED TO SEND ALIVE MESSAGE"));
+					}
+				#endif
+				_sendFrame(_address, GNMSUP1_SYSTEMSERVICENUMBER, GNMSUP1_SYSTEMSERVICE_QUERYALIVE, true, additionalPushMessagesFlag, false, pushAnswerCommitReceiveFlag, false, empty, 0);
+				return false;
+				
+			case GNMSUP1_SYSTEMSERVICE_REGISTERWRITE:																								// Write of the Master into the Register-Map
+				if (_registerMap && _registerMap->apply(&frame[GNMSUP1_FRAMEBUF_PAYLOADSTART], frame[GNMSUP1_FRAMEBUF_PAYLOADSIZE])) {
+					_registerDispatch(frame);
+				}
+				return pushFlag;
+				
+			case GNMSUP1_SYSTEMSERVICE_SEGMENTBEGIN:																								// Segmented Transfer: (re)start the Reassembly, answer with the Ack
+				{
+					bool accepted = _reassemblyBegin(frame);
+					if (pushFlag) {
+						_reassemblyAcknowledge(accepted, additionalPushMessagesFlag);
+					}
+				}
+				return false;
+				
+			case GNMSUP1_SYSTEMSERVICE_SEGMENTDATA:																									// Segmented Transfer: store the Segment, answer the Push-Request of the Window with the Ack
+				_reassemblySegment(frame);
+				if (pushFlag) {
+					_reassemblyAcknowledge(_reassemblyActive, additionalPushMessagesFlag);
+				}
+				return false;
+				
+			case GNMSUP1_SYSTEMSERVICE_CAPABILITIES:																								// Capability-Query: answer with Limits, Features and Baudrates
+				_capabilitiesAnswer(additionalPushMessagesFlag, pushAnswerCommitReceiveFlag);
+				return false;
+				
+			case GNMSUP1_SYSTEMSERVICE_BAUDSWITCH:																									// Baudrate-Switch (Broadcast): switch, wait for the Commit
+				_baudSwitchReceive(frame);
+				return false;
+				
+			case GNMSUP1_SYSTEMSERVICE_BAUDCOMMIT:																									// Commit of the Baudrate-Switch: stay at the new Rate
+				_baudFallbackPending = false;
+				_baudWindow.disarm();
+				_sendFrame(_address, GNMSUP1_SYSTEMSERVICENUMBER, GNMSUP1_SYSTEMSERVICE_BAUDCOMMIT, true, additionalPushMessagesFlag, false, pushAnswerCommitReceiveFlag, false, empty, 0);
+				return false;
+				
+			case GNMSUP1_SYSTEMSERVICE_IGNORE:																											// Ignore-Service (ignore :-)
+				#ifdef GNMSUP1_DEBUG
+					if (_debugAttached) {
+						_debugStream->println(F("GOT A IGNORE-PACKET"));
+					}
+				#endif
+				return pushFlag;
+			
+			default:																																								// Not implemented
+				#ifdef GNMSUP1_DEBUG
+					if (_debugAttached) {
+						_debugStream->print(F("ERR:SYSTEM-SERVICE 0x"));
+						_debugPrintHex(frame[GNMSUP1_FRAMEBUF_SUBSERVICE]);
+						_debugStream->println(F(": NOT IMPLEMENTED"));
+						_debugStream->println();
+					}
+				#endif
+				return pushFlag;
+		}
+	}
+}
+
+
+
+// RegisterDispatch -> Invokes the Register-Callback for every Span (Record) of the Frame
+template <class Config>
+void gnMsup1Bus<Config>::_registerDispatch(const uint8_t frame[]) {
+	if (!_registerHandler) {
+		return;
+	}
+	
+	uint8_t position = 0;
+	uint16_t offset;
+	const uint8_t* data;
+	uint8_t length;
+	while (gnMsup1RegisterMap::record(&frame[GNMSUP1_FRAMEBUF_PAYLOADSTART], frame[GNMSUP1_FRAMEBUF_PAYLOADSIZE], position, offset, data, length)) {
+		_registerHandler(frame[GNMSUP1_FRAMEBUF_ADDRESS], offset, data, length);
+	}
+}
+
+
+
+// ReassemblyBegin -> Starts the Reassembly of a Transfer (Slave); false if no Receiver is attached or the Buffer is too small
+template <class Config>
+bool gnMsup1Bus<Config>::_reassemblyBegin(const uint8_t frame[]) {
+	const uint8_t* begin = &frame[GNMSUP1_FRAMEBUF_PAYLOADSTART];
+	uint32_t length = ((uint32_t)begin[3] << 16) | ((uint16_t)begin[4] << 8) | begin[5];
+	_reassemblyActive = frame[GNMSUP1_FRAMEBUF_PAYLOADSIZE] >= GNMSUP1_SEGMENT_BEGINSIZE && begin[2] > 0 &&
+											(_reassemblySink || (_reassemblyBuffer && length <= _reassemblyBufferSize));
+	if (!_reassemblyActive) {
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->println(F("ERR: TRANSFER REJECTED (NO RECEIVER OR BUFFER TOO SMALL)"));
+			}
+		#endif
+		return false;
+	}
+	
+	_reassemblyServiceNumber = begin[0];
+	_reassemblySubserviceNumber = begin[1];
+	_reassemblySegmentSize = begin[2];
+	_reassemblyLength = length;
+	_reassemblySegments = (length + _reassemblySegmentSize - 1) / _reassemblySegmentSize;
+	_reassemblyNext = 0;
+	_reassemblyReceived = 0;
+	if (_reassemblySegments == 0 && _reassemblyHandler) {																				// Empty Transfer: complete at once
+		_reassemblyHandler(_reassemblyServiceNumber, _reassemblySubserviceNumber, 0, frame[GNMSUP1_FRAMEBUF_ADDRESS]);
+	}
+	return true;
+}
+
+
+
+// ReassemblySegment -> Delivers a Segment within the Window to the Buffer or Sink (once) and advances past the received ones
+template <class Config>
+void gnMsup1Bus<Config>::_reassemblySegment(const uint8_t frame[]) {
+	const uint8_t* segment = &frame[GNMSUP1_FRAMEBUF_PAYLOADSTART];
+	if (!_reassemblyActive || frame[GNMSUP1_FRAMEBUF_PAYLOADSIZE] < GNMSUP1_SEGMENT_HEADER) {
+		return;
+	}
+	
+	uint16_t sequence = (segment[0] << 8) | segment[1];
+	uint16_t position = sequence - _reassemblyNext;
+	if (sequence >= _reassemblySegments || position >= 16 || bitRead(_reassemblyReceived, position)) {	// Outside the Window, or a Duplicate
+		return;
+	}
+	uint32_t offset = (uint32_t)sequence * _reassemblySegmentSize;
+	uint8_t length = (_reassemblyLength - offset < _reassemblySegmentSize) ? _reassemblyLength - offset : _reassemblySegmentSize;
+	if (frame[GNMSUP1_FRAMEBUF_PAYLOADSIZE] != GNMSUP1_SEGMENT_HEADER + length) {
+		return;
+	}
+	
+	if (_reassemblySink) {
+		_reassemblySink(offset, &segment[GNMSUP1_SEGMENT_HEADER], length);
+	} else {
+		memcpy(&_reassemblyBuffer[offset], &segment[GNMSUP1_SEGMENT_HEADER], length);
+	}
+	bitSet(_reassemblyReceived, position);
+	while (bitRead(_reassemblyReceived, 0)) {																										// Slide the Window over the received Segments
+		_reassemblyReceived >>= 1;
+		_reassemblyNext++;
+	}
+	
+	if (_reassemblyNext == _reassemblySegments && _reassemblyHandler) {
+		_reassemblyHandler(_reassemblyServiceNumber, _reassemblySubserviceNumber, _reassemblyLength, frame[GNMSUP1_FRAMEBUF_ADDRESS]);
+	}
+}
+
+
+
+// ReassemblyAcknowledge -> Answers the Push-Request of a Window with next missing Segment and Bitmap (empty Ack: rejected)
+template <class Config>
+void gnMsup1Bus<Config>::_reassemblyAcknowledge(bool accepted, bool additionalPushMessagesFlag) {
+	uint8_t ack[GNMSUP1_SEGMENT_ACKSIZE] = {highByte(_reassemblyNext), lowByte(_reassemblyNext), highByte(_reassemblyReceived), lowByte(_reassemblyReceived)};
+	_sendFrame(_address, GNMSUP1_SYSTEMSERVICENUMBER, GNMSUP1_SYSTEMSERVICE_SEGMENTACK, true, additionalPushMessagesFlag, false, false, false, ack, accepted ? GNMSUP1_SEGMENT_ACKSIZE : 0);
+}
+
+
+
+// PushBlockingWaitForRelease -> Waits until Push-Answer received or Push-Request timeouted (only call after prechecking Mode and pushBlockingActive()!)
+template <class Config>
+void gnMsup1Bus<Config>::_pushBlockingWaitForRelease() {
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->println(F("WRN: PUSH-ANSWER OPEN; MODE ENFORCE BLOCKING WAIT."));
+		}
+	#endif
+	
+	while (_pushBlocking.running(_timer)) {
+		_handleCommunication(false);
+	}
+}
+
+
+
+// PushStoreFront -> Gets the most urgent Entry (oldest of the highest Class) after dropping the expired ones; returns NULL if empty
+template <class Config>
+typename gnMsup1Bus<Config>::_pushStore_t* gnMsup1Bus<Config>::_pushStoreFront() {
+	_pushStoreExpire();
+	for (int8_t priority = GNMSUP1_PUSHPRIORITIES - 1; priority >= 0; priority--) {
+		if (_pushClassCount[priority] > 0) {
+			return &_pushStore[_pushClassHead[priority]];
+		}
+	}
+	return NULL;
+}
+
+
+
+// PushStoreEnqueue -> Links a free Slot behind the newest Entry of its Class; when full, expired Entries make Room, else the oldest
+//                     Entry of a less urgent Class gets dropped. Returns NULL if full
+template <class Config>
+typename gnMsup1Bus<Config>::_pushStore_t* gnMsup1Bus<Config>::_pushStoreEnqueue(uint8_t priority, uint32_t lifetimeMs) {
+	if (priority >= GNMSUP1_PUSHPRIORITIES) {
+		priority = GNMSUP1_PUSHPRIORITIES - 1;
+	}
+	if (_pushStoreCount == Config::maxPushQueueEntries) {																					// Full: make Room by dropping expired Entries
+		_pushStoreExpire();
+	}
+	for (uint8_t lower = 0; lower < priority && _pushStoreCount == Config::maxPushQueueEntries; lower++) {		// Still full: a less urgent Message gives way
+		if (_pushClassCount[lower] > 0) {
+			_pushStoreRemove(_pushClassHead[lower]);
+			_statisticsCount(_address, &Statistics::pushQueueDrops);
+		}
+	}
+	if (_pushStoreCount == Config::maxPushQueueEntries) {
+		return NULL;
+	}
+	
+	PushIndex slot;
+	if (_pushFreeCount > 0) {																																		// Reuse a released Slot, else the next never used one
+		slot = _pushFreeHead;
+		_pushFreeHead = _pushStore[slot].next;
+		_pushFreeCount--;
+	} else {
+		slot = _pushStoreFresh++;
+	}
+	if (_pushClassCount[priority] > 0) {
+		_pushStore[_pushClassTail[priority]].next = slot;
+	} else {
+		_pushClassHead[priority] = slot;
+	}
+	_pushClassTail[priority] = slot;
+	_pushClassCount[priority]++;
+	
+	_pushStore_t* entry = &_pushStore[slot];
+	entry->flags = 0x00;
+	bitSet(entry->flags, GNMSUP1_PUSHBUFFLAG_QUEUED);
+	entry->priority = priority;
+	entry->ticket = _pushStoreTickets++;
+	entry->expiry = _timer.millis() + (lifetimeMs ? lifetimeMs : Config::pushQueueTimeout);
+	if (_pushStoreCount == 0 || (int32_t)(entry->expiry - _pushStoreExpiry) < 0) {
+		_pushStoreExpiry = entry->expiry;
+	}
+	_pushStoreCount++;
+	return entry;
+}
+
+
+
+// PushStoreRemove -> Unlinks an Entry from its Class and releases the Slot; the Class-Heads (the usual Case) go without a Walk
+template <class Config>
+void gnMsup1Bus<Config>::_pushStoreRemove(PushIndex slot) {
+	PushIndex previous = _pushClassHead[_pushStore[slot].priority];
+	if (previous != slot) {
+		while (_pushStore[previous].next != slot) {
+			previous = _pushStore[previous].next;
+		}
+	}
+	_pushStoreRemove(slot, previous);
+}
+
+
+
+// PushStoreRemove -> Unlinks an Entry behind previous (itself for the Head of the Class) and releases the Slot
+template <class Config>
+void gnMsup1Bus<Config>::_pushStoreRemove(PushIndex slot, PushIndex previous) {
+	uint8_t priority = _pushStore[slot].priority;
+	if (previous == slot) {
+		_pushClassHead[priority] = _pushStore[slot].next;
+	} else {
+		_pushStore[previous].next = _pushStore[slot].next;
+		if (_pushClassTail[priority] == slot) {
+			_pushClassTail[priority] = previous;
+		}
+	}
+	_pushClassCount[priority]--;
+	_pushStoreCount--;
+	
+	bitClear(_pushStore[slot].flags, GNMSUP1_PUSHBUFFLAG_QUEUED);
+	_pushStore[slot].next = _pushFreeHead;
+	_pushFreeHead = slot;
+	_pushFreeCount++;
+}
+
+
+
+// PushStoreExpire -> Drops the Entries past their Deadline; sweeps the Store only once the earliest Deadline passed
+template <class Config>
+void gnMsup1Bus<Config>::_pushStoreExpire() {
+	if (_pushStoreCount == 0 || (int32_t)(_timer.millis() - _pushStoreExpiry) <= 0) {
+		return;
+	}
+	
+	uint32_t millisbuffer = _timer.millis();
+	bool first = true;
+	for (uint8_t priority = 0; priority < GNMSUP1_PUSHPRIORITIES; priority++) {
+		PushIndex slot = _pushClassHead[priority];
+		PushIndex previous = slot;																																	// Last Entry kept (the Slot itself while none)
+		for (PushIndex i = _pushClassCount[priority]; i > 0; i--) {
+			PushIndex next = _pushStore[slot].next;
+			if ((int32_t)(millisbuffer - _pushStore[slot].expiry) > 0) {
+				_pushStoreRemove(slot, previous);
+				_statisticsCount(_address, &Statistics::pushQueueDrops);
+				if (previous == slot) {
+					previous = next;
+				}
+			} else {
+				if (first || (int32_t)(_pushStore[slot].expiry - _pushStoreExpiry) < 0) {									// Earliest Deadline left
+					_pushStoreExpiry = _pushStore[slot].expiry;
+					first = false;
+				}
+				previous = slot;
+			}
+			slot = next;
+		}
+	}
+}
+
+
+
+// TxBusy -> True while a Frame is on the Line (DE set)
+template <class Config>
+bool gnMsup1Bus<Config>::txBusy() {
+	_txService(false);
+	return _txBusy;
+}
+
+
+
+// TxStart -> A Frame is queued in the Transport; release DE now (wait) or later from handleCommunication
+template <class Config>
+void gnMsup1Bus<Config>::_txStart(uint8_t address, bool wait) {
+	_txBusy = true;
+	_txAddress = address;
+	_txService(wait);
+}
+
+
+
+// TxService -> Releases DE once the Transport reports the Frame out (or waits for it) and marks the Completion
+template <class Config>
+void gnMsup1Bus<Config>::_txService(bool wait) {
+	if (!_txBusy) {
+		return;
+	}
+	
+	if (wait) {
+		_transport->flush();
+	} else if (!_transport->txComplete()) {
+		return;
+	}
+	_transport->setDriverEnable(false);																													// Release DE for RS485
+	_txBusy = false;
+	_txCompletePending = true;
+	
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->println(F("<RS485 DE-PIN RELEASED"));
+		}
+	#endif
+}
+
+
+
+// TxReport -> Invokes the TX-Complete Callback for the last Frame, if its Completion is pending
+template <class Config>
+void gnMsup1Bus<Config>::_txReport() {
+	if (_txCompletePending) {
+		_txCompletePending = false;
+		if (_txCompleteHandler) {
+			_txCompleteHandler(_txAddress);
+		}
+	}
+}
+
+
+
+// SendFrame -> Internal Send Function
+template <class Config>
+bool gnMsup1Bus<Config>::_sendFrame(uint8_t address, uint8_t serviceNumber, uint8_t subserviceNumber, bool serviceFlag, bool pushFlag, bool waitForPushAnswer, bool commitReceivedFlag, bool retryOnCrFailure, uint8_t payload[], uint8_t payloadSize, CommitReceiveCallback commitReceiveHandler) {
+	if (_queryIgnore(address)) {																																// Check if this Node should be ignored
+		#ifdef GNMSUP1_DEBUG
+			if (_debugAttached) {
+				_debugStream->print(F("WRN: ADDRESS 0x"));
+				_debugPrintHex(address);
+				_debugStream->println(F(" IS INACTIVE, SKIP SEND-REQUEST."));
+			}
+		#endif
+		return false;
+	}
+	
+	while (_rxPending()) {																																			// Process incoming Packets before sending anything
+		_handleCommunication(false);
+	}
+	while (_crPending) {																																				// Collect a pending CommitReceive first
+		_crService();
+	}
+	_txService(true);																																						// One Frame on the Line at a Time: finish and report the previous one
+	_txReport();
+	
+	_transport->setDriverEnable(true);																													// Set DE for RS485
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->println(F("<RS485 DE-PIN SET"));
+		}
+	#endif
+	
+	uint16_t framebufferLength = 0;																																// Build the Frame in the Transmit-Buffer
+	uint8_t flagbyte = 0x00;
+	bitWrite(flagbyte, GNMSUP1_FRAMEFLAG_DIRECTION, (!_ownsMasterRole()));
+	bitWrite(flagbyte, GNMSUP1_FRAMEFLAG_SERVICE, serviceFlag);
+	bitWrite(flagbyte, GNMSUP1_FRAMEFLAG_PUSH, pushFlag);
+	bitWrite(flagbyte, GNMSUP1_FRAMEFLAG_COMMITRECEIVE, commitReceivedFlag);
+	_txBuffer[GNMSUP1_FRAMEBUF_FLAG] = flagbyte;
+	_txBuffer[GNMSUP1_FRAMEBUF_ADDRESS] = address;
+	if (serviceFlag) {
+		framebufferLength = 5 + payloadSize;
+		_txBuffer[GNMSUP1_FRAMEBUF_PAYLOADSIZE] = payloadSize;
+		_txBuffer[GNMSUP1_FRAMEBUF_SERVICE] = serviceNumber;
+		_txBuffer[GNMSUP1_FRAMEBUF_SUBSERVICE] = subserviceNumber;
+		_txChecksum = gnMsup1Crc16::compute(_txBuffer, GNMSUP1_FRAMEBUF_PAYLOADSTART);										// CRC16 of the Header, the Payload gets folded in while copied
+		for (uint8_t i = 0; i < payloadSize; i++) {
+			_txBuffer[GNMSUP1_FRAMEBUF_PAYLOADSTART + i] = payload[i];
+			_txChecksum = gnMsup1Crc16::update(_txChecksum, payload[i]);
+		}
+	} else {
+		framebufferLength = 2;
+		_txChecksum = gnMsup1Crc16::compute(_txBuffer, framebufferLength);
+	}
+
+	_txLength = framebufferLength;
+	_txWriteFrame();																																						// Write-Out StartBytes, FrameBuffer, StopBytes and wait for complete...
+	_statisticsCount(address, &Statistics::framesSent);
+	
+	if (commitReceivedFlag) {																																		// Track the CommitReceive; wait for it unless a Callback takes the Result
+		_crStart(address, retryOnCrFailure && _ownsMasterRole(), commitReceiveHandler);
+		if (!commitReceiveHandler) {
+			while (_crPending) {
+				_crService();
+			}
+			if (_crResult != None) {
+				return false;
+			}
+		}
+	}
+	
+	if (_ownsMasterRole() && pushFlag && waitForPushAnswer) {																		// If requested, wait for Answer or Timeout (only Push-Requests form the Master)
+		_pushBlockingWaitForRelease();
+	}
+
+	return true;
+}
+
+
+
+// TxWriteFrame -> Writes the Frame in the Transmit-Buffer (StartBytes, Buffer, CRC16, StopBytes) to the Transport
+template <class Config>
+void gnMsup1Bus<Config>::_txWriteFrame() {
+	bool pushFlag = bitRead(_txBuffer[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_PUSH);
+	bool commitReceivedFlag = bitRead(_txBuffer[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_COMMITRECEIVE);
+	
+	_timer.refresh();																																						// The Timers armed by this Frame (Push-Blocking, CR) start now
+	_transport->write(GNMSUP1_FRAMESTART1);																												// Write-Out StartBytes, FrameBuffer, StopBytes and wait for complete...
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->print(F("<0x00\t0x"));
+			_debugPrintHex(GNMSUP1_FRAMESTART1);
+			_debugStream->println(F("\tSTART"));
+		}
+	#endif
+	_transport->write(GNMSUP1_FRAMESTART2);
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->print(F("<0x01\t0x"));
+			_debugPrintHex(GNMSUP1_FRAMESTART2);
+			_debugStream->println();
+		}
+	#endif
+	
+	if (_ownsMasterRole() && pushFlag) {																												// Set the Push-Blocker (only as Master relevant)
+		_pushBlockingSet(_txBuffer[GNMSUP1_FRAMEBUF_ADDRESS], _txLength + GNMSUP1_FRAMEOVERHEAD);
+		#ifdef GNMSUP1_STATISTICS
+			_statisticsPushAddress = _txBuffer[GNMSUP1_FRAMEBUF_ADDRESS];
+			_statisticsPushMicros = _timer.micros();
+		#endif
+	}
+	
+	_transport->write(_txBuffer, _txLength);
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			for (uint8_t i = 0; i < _txLength; i++) {
+				_debugStream->print(F("<0x"));
+				_debugPrintHex(2 + i);
+				_debugStream->print(F("\t0x"));
+				_debugPrintHex(_txBuffer[i]);
+				switch (i) {
+					case GNMSUP1_FRAMEBUF_FLAG:
+						_debugStream->print(F("\tDIR:"));
+						_debugStream->print(bitRead(_txBuffer[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_DIRECTION), BIN);
+						_debugStream->print(F(", SERVICE:"));
+						_debugStream->print(bitRead(_txBuffer[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_SERVICE), BIN);
+						_debugStream->print(F(", PUSH:"));
+						_debugStream->print(bitRead(_txBuffer[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_PUSH), BIN);
+						_debugStream->print(F(", CR:"));
+						_debugStream->print(bitRead(_txBuffer[GNMSUP1_FRAMEBUF_FLAG], GNMSUP1_FRAMEFLAG_COMMITRECEIVE), BIN);
+						break;
+					case GNMSUP1_FRAMEBUF_ADDRESS:
+						_debugStream->print(F("\tADDR"));
+						break;
+					case GNMSUP1_FRAMEBUF_PAYLOADSIZE:
+						_debugStream->print(F("\tPAYLOAD-LEN"));
+						break;
+					case GNMSUP1_FRAMEBUF_SERVICE:
+						_debugStream->print(F("\tSERVICE"));
+						break;
+					case GNMSUP1_FRAMEBUF_SUBSERVICE:
+						_debugStream->print(F("\tSUBSERVICE"));
+						break;
+					default:
+						_debugStream->print(F("\tPAYLOAD:0x"));
+						_debugPrintHex(i - GNMSUP1_FRAMEBUF_PAYLOADSTART);
+				}
+				_debugStream->println();
+			}
+		}
+	#endif
+	
+	_transport->write(highByte(_txChecksum));
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->print(F("<0x"));
+			_debugPrintHex(2 + _txLength);
+			_debugStream->print(F("\t0x"));
+			_debugPrintHex(highByte(_txChecksum));
+			_debugStream->println(F("\tCRC16"));
+		}
+	#endif
+	_transport->write(lowByte(_txChecksum));
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->print(F("<0x"));
+			_debugPrintHex(3 + _txLength);
+			_debugStream->print(F("\t0x"));
+			_debugPrintHex(lowByte(_txChecksum));
+			_debugStream->println();
+		}
+	#endif
+	
+	_transport->write(GNMSUP1_FRAMESTOP1);
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->print(F("<0x"));
+			_debugPrintHex(4 + _txLength);
+			_debugStream->print(F("\t0x"));
+			_debugPrintHex(GNMSUP1_FRAMESTOP1);
+			_debugStream->println(F("\tSTOP"));
+		}
+	#endif
+	_transport->write(GNMSUP1_FRAMESTOP2);
+	_txStart(_ownsMasterRole() ? _txBuffer[GNMSUP1_FRAMEBUF_ADDRESS] : GNMSUP1_MASTERPSEUDOADDRESS,				// Timing sensitive: Hold back any Debug-Output for later; wait till all Bytes are written out
+					 !_txAsync || commitReceivedFlag || (_ownsMasterRole() && pushFlag));									// unless nothing gets answered and the Transmission is asynchronous
+	
+	#ifdef GNMSUP1_DEBUG																																				// Now its time for Debug-Informations
+		if (_debugAttached) {
+			_debugStream->print(F("<0x"));
+			_debugPrintHex(5 + _txLength);
+			_debugStream->print(F("\t0x"));
+			_debugPrintHex(GNMSUP1_FRAMESTOP2);
+			_debugStream->println();
+		}
+	#endif
+}
+
+
+
+// CrStart -> Records the pending CommitReceive of the Frame just sent; handleCommunication collects the CRC16-Echo
+template <class Config>
+void gnMsup1Bus<Config>::_crStart(uint8_t address, bool retry, CommitReceiveCallback handler) {
+	_crPending = true;
+	_crAddress = address;
+	_crRetry = retry;
+	_crHandler = handler;
+	_crReceived = 0;
+	_timer.refresh();																																						// The Frame is flushed: the Window counts from its last Stop-Bit
+	_crDeadline.arm(_timer, _crTimeoutFor(address));
+}
+
+
+
+// CrService -> Collects the CRC16-Echo; on Mismatch or Timeout resends the Frame once (if requested) or reports the Failure
+template <class Config>
+void gnMsup1Bus<Config>::_crService() {
+	if (!_crPending) {
+		return;
+	}
+	
+	_timer.refresh();																																						// Also spins in Wait-Loops of its own (without handleCommunication)
+	_crReceived += _transport->read(&_crBuffer[_crReceived], 2 - _crReceived);
+	ComErrorCode result;
+	if (_crReceived == 2) {
+		result = (_crBuffer[0] == highByte(_txChecksum) && _crBuffer[1] == lowByte(_txChecksum)) ? None : Err_CRInvalid;
+	} else if (!_crDeadline.running(_timer)) {
+		result = Err_CRTimeout;
+	} else {
+		return;
+	}
+	
+	if (_crReceived == 2) {
+		_statisticsLatency(_crAddress, &Statistics::crLatency, _crDeadline.start());
+	}
+	_adaptiveCr(result);
+	if (result != None) {
+		_statisticsCount(_crAddress, result == Err_CRInvalid ? &Statistics::crInvalid : &Statistics::crTimeouts);
+	}
+	
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			switch (result) {
+				case None:						_debugStream->println(F("CR VALID"));				break;
+				case Err_CRInvalid:	_debugStream->println(F("ERR: CR INVALID"));	break;
+				default:											_debugStream->println(F("ERR: CR TIMEOUT"));	break;
+			}
+		}
+	#endif
+	
+	if (result == None) {
+		_markActive(_crAddress);
+	} else {
+		_lastComError.comErrorCode = result;
+		_lastComError.address = _crAddress;
+		
+		if (_crRetry) {																																						// Allow master to retry, if requested; the Frame is still in the Transmit-Buffer
+			#ifdef GNMSUP1_DEBUG
+				if (_debugAttached) {
+					_debugStream->println(F("RETRY..."));
+				}
+			#endif
+			_statisticsCount(_crAddress, &Statistics::retries);
+			_transport->setDriverEnable(true);
+			_txWriteFrame();
+			_crStart(_crAddress, false, _crHandler);
+			return;
+		}
+		if (result == Err_CRTimeout && _crDeadline.period() >= _frameTimeout * 4 / 10) {									// Inactive only after the fixed Timeout; a learned one just backs off
+			_markIgnore(_crAddress);
+		}
+	}
+	
+	if (_probeAwaiting && _crAddress == _probeAddress) {
+		_probeResult(result);
+	}
+	_crPending = false;
+	_crResult = result;
+	if (_crHandler) {
+		_crHandler(_crAddress, result);
+	}
+}
+
+
+
+// Query if a Node should be ignored (on Slaves return always false, if IgnoreInactiveNodes is off return always false)
+template <class Config>
+bool gnMsup1Bus<Config>::_queryIgnore(uint8_t address) {
+	if (!(_ownsMasterRole()) || !(_ignoreInactiveNodes)) {																			// Shortcut for Slaves or inactive IgnoreInactiveNodes Mode
+		return false;
+	} else {																																										// Return IgnoreStore Value (invalid Addresses never set)
+		return _ignoreStore.test(address);
+	}
+}
+
+
+
+// Query if a Node is known as active (if IgnoreInactiveNodes is off return always true)
+template <class Config>
+bool gnMsup1Bus<Config>::_queryActive(uint8_t address) {
+	if (!(_ignoreInactiveNodes)) {																															// Shortcut while inactive IgnoreInactiveNodes Mode
+		return true;
+	} else {																																										// Return ActiveStore Value (invalid Addresses never set)
+		return _activeStore.test(address);
+	}
+}
+
+
+
+// Mark a Node as Active (don't ignore him)
+template <class Config>
+void gnMsup1Bus<Config>::_markActive(uint8_t address) {
+	_activeStore.set(address);
+	_ignoreStore.clear(address);
+	_lostStore.clear(address);
+}
+
+
+
+// Mark a Node as Inactive (ignore him until the Scavenging reaches him); an active one counts as lost: the Scavenging probes it first
+template <class Config>
+void gnMsup1Bus<Config>::_markIgnore(uint8_t address) {
+	if (!_ignoreStore.test(address) && !(_probeAwaiting && address == _probeAddress)) {					// A failed Probe doesn't count as Transition again
+		_statisticsCount(address, &Statistics::ignoreTransitions);
+	}
+	if (_activeStore.test(address)) {
+		_lostStore.set(address);
+	}
+	_activeStore.clear(address);
+	_ignoreStore.set(address);
+}
+
+
+
+// Scavenging inactive-Node Store (when needed) -> Every Interval the ignored Nodes form a new Round and the Budget refills;
+//                                                 the Probes themselves run in _probeService (no blocking Send here)
+template <class Config>
+void gnMsup1Bus<Config>::_scavengingInactive() {
+	if (_ignoreInactiveNodes && _ownsMasterRole()) {																							// Proceed only when... IgnoreInactiveNodes active
+		if (_timer.millis() - _scavengingInactiveLastTimestamp > GNMSUP1_SCAVENGINGINACTIVEINTERVAL) {	// ... and Interval necessary
+			_scavengingInactiveLastTimestamp = _timer.millis();
+			_scavengingRound = _ignoreStore;
+			_scavengingBudget = GNMSUP1_SCAVENGINGBUDGET;
+			#ifdef GNMSUP1_DEBUG
+				if (_debugAttached && _scavengingRound.any()) {
+					_debugStream->print(F("SCAVENGING INACTIVE NODES: "));
+					_debugStream->println(_scavengingRound.count());
+				}
+			#endif
+		}
+	}
+}
+
+
+
+// StartDiscovery -> Queues a Probe for every Address of the Range not yet known as active; the Probes run from handleCommunication
+template <class Config>
+bool gnMsup1Bus<Config>::startDiscovery(uint8_t beginAddress, uint8_t endAddress, DiscoveryCompleteCallback completeHandler) {
+	if (!_initialized || !_ownsMasterRole() || _discoveryActive) {
+		return false;
+	}
+	if (beginAddress > endAddress || endAddress > Config::maxSlaveAddress) {
+		return false;
+	}
+	
+	_discoveryActive = true;
+	_discoveryBeginAddress = beginAddress;
+	_discoveryEndAddress = endAddress;
+	_discoveryFound = 0;
+	_discoveryCompleteHandler = completeHandler;
+	_probePending.setRange(beginAddress, endAddress);
+	return true;
+}
+
+
+
+// ProbeService -> Sends the next Probe once the previous one is done: Discovery first, then the Scavenging-Round within its Budget
+//                 (lost Nodes first, the last Probe of the Budget goes Round-Robin to the others)
+template <class Config>
+void gnMsup1Bus<Config>::_probeService() {
+	if (_probeAwaiting || _pushBlocking.running(_timer) || _crPending) {
+		return;
+	}
+	
+	if (_discoveryActive) {
+		uint16_t address = _probePending.find(0);
+		while (address < AddressSet::bits && _activeStore.test(address)) {												// Already answered: no Probe needed
+			_probePending.clear(address);
+			_discoveryFound++;
+			address = _probePending.find(address);
+		}
+		if (address < AddressSet::bits) {
+			_probePending.clear(address);
+			_probeSend(address, false);
+			return;
+		}
+		_discoveryActive = false;
+		if (_discoveryCompleteHandler) {
+			_discoveryCompleteHandler(_discoveryBeginAddress, _discoveryEndAddress, _discoveryFound);
+		}
+	}
+	
+	while (_ignoreInactiveNodes && _scavengingBudget) {
+		AddressSet lost = _scavengingRound;
+		lost.intersect(_lostStore);
+		uint16_t address = (_scavengingBudget > 1) ? lost.find(0) : AddressSet::bits;
+		if (address == AddressSet::bits) {
+			address = _scavengingRound.find(_scavengingInactiveNextAddress);
+			if (address == AddressSet::bits) {
+				address = _scavengingRound.find(0);
+			}
+			if (address == AddressSet::bits) {																											// Round done
+				return;
+			}
+			_scavengingInactiveNextAddress = (address + 1) % AddressSet::bits;
+		}
+		_scavengingRound.clear(address);
+		if (_ignoreStore.test(address)) {																													// Else it answered meanwhile
+			_probeSend(address, true);
+			return;
+		}
+	}
+}
+
+
+
+// ProbeSend -> Ignore-Service with CommitReceive to one Address; the CRC16-Echo within GNMSUP1_PROBETIMEOUT tells if the Node is alive
+template <class Config>
+void gnMsup1Bus<Config>::_probeSend(uint8_t address, bool scavenging) {
+	#ifdef GNMSUP1_DEBUG
+		if (_debugAttached) {
+			_debugStream->print(F("PROBE 0x"));
+			_debugPrintHex(address);
+			_debugStream->println();
+		}
+	#endif
+	
+	_ignoreStore.clear(address);																																// Let the Frame pass _queryIgnore
+	_probeAwaiting = true;
+	_probeScavenging = scavenging;
+	_probeAddress = address;
+	_probeComError = _lastComError;
+	if (!_sendFrame(address, GNMSUP1_SYSTEMSERVICENUMBER, GNMSUP1_SYSTEMSERVICE_IGNORE, true, false, false, true, false, nullptr, 0, _probeNoWait)) {
+		_probeResult(Err_CRTimeout);
+		return;
+	}
+	uint32_t window = _airtime(2) + (uint32_t)GNMSUP1_PROBETIMEOUT * 1000;														// The CR-Window starts after the Probe: Echo on the Line plus Turnaround
+	if (_crPending && _crDeadline.period() > window) {																						// An absent Node costs the Probe-Timeout only
+		_crDeadline.arm(_timer, window);
+	}
+}
+
+
+
+// ProbeResult -> Marks the probed Node active or inactive; only a failed Scavenging-Probe uses up the Budget
+template <class Config>
+void gnMsup1Bus<Config>::_probeResult(ComErrorCode result) {
+	if (result == None) {
+		_markActive(_probeAddress);
+		if (!_probeScavenging) {
+			_discoveryFound++;
+		}
+	} else {
+		_markIgnore(_probeAddress);
+		if (_probeScavenging) {
+			_scavengingBudget--;
+		}
+	}
+	_probeAwaiting = false;
+	_lastComError = _probeComError;																															// Probes report no Errors
+}
+
+
+
+#ifdef GNMSUP1_DEBUG
+	// DebugPrintHex -> Print a formatted hex-number (0x01 instead of 0x1)
+	template <class Config>
+	void gnMsup1Bus<Config>::_debugPrintHex(uint8_t value) {
+		if (_debugAttached) {
+			if (value < 0x10) {
+				_debugStream->print(0);
+			}
+			_debugStream->print(value, HEX);
+		}
+	}
+#endif
+#endif	// #ifndef gnMsup1Impl_h
@@ -0,0 +1,104 @@
+/*  GN Master Slave Universal Protocol Library
+ *  ==========================================
+ *
+ *  Library for generic Master/Slave Communications.
+ *
+ *  Platform Abstraction: maps the few Arduino-Core Functions used by the Library to a plain POSIX Host (Linux Gateway,
+ *  Load-Tests), so the Protocol Engine builds outside of the Arduino Environment.
+ *
+ *	MIT License
+ *
+ *	Copyright (c) 2018 Andreas Gloor
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+
+
+ // Assure the Library gets loaded not more than once
+#ifndef gnMsup1Platform_h
+#define gnMsup1Platform_h
+
+
+
+#if defined(ARDUINO)																																					// Arduino-Core: use the original Functions
+	#define GNMSUP1_PLATFORM_ARDUINO
+	#include <Arduino.h>
+
+	#ifdef __AVR__																																							// Constant Tables can live in the Flash (PROGMEM)
+		#define gnMsup1MemcpyFlash(destination, source, length)		memcpy_P(destination, source, length)
+	#else
+		#define gnMsup1MemcpyFlash(destination, source, length)		memcpy(destination, source, length)
+	#endif
+#else																																													// POSIX Host: provide the used Subset of the Arduino-Core
+	#define GNMSUP1_PLATFORM_POSIX
+	#include <stdint.h>
+	#include <stddef.h>
+	#include <string.h>
+	#include <time.h>
+	#include <unistd.h>
+
+	#ifdef GNMSUP1_DEBUG																																				// Debug-Output relies on Arduino-Streams; not available on the Host
+		#undef GNMSUP1_DEBUG
+	#endif
+
+	#define bitRead(value, bit)									(((value) >> (bit)) & 0x01)
+	#define bitSet(value, bit)									((value) |= (1ul << (bit)))
+	#define bitClear(value, bit)								((value) &= ~(1ul << (bit)))
+	#define bitWrite(value, bit, bitvalue)			((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+	#define highByte(w)													((uint8_t)((w) >> 8))
+	#define lowByte(w)													((uint8_t)((w) & 0xFF))
+	#define F(string_literal)										(string_literal)
+	#define PROGMEM
+	#define gnMsup1MemcpyFlash(destination, source, length)		memcpy(destination, source, length)
+
+	struct gnMsup1ClockSource {																																	// Replaces the Monotonic Clock, e.g. by the virtual Clock of gnMsup1Simulator
+		uint64_t	(*micros) (void* context);
+		void*			context;
+	};
+	inline gnMsup1ClockSource& gnMsup1Clock() {																									// One per Process; micros == nullptr: Monotonic Clock
+		static gnMsup1ClockSource source = {nullptr, nullptr};
+		return source;
+	}
+
+	inline uint64_t gnMsup1Micros64() {
+		gnMsup1ClockSource& source = gnMsup1Clock();
+		if (source.micros) {
+			return source.micros(source.context);
+		}
+		struct timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		return (uint64_t)now.tv_sec * 1000000ull + now.tv_nsec / 1000ul;
+	}
+
+	inline uint32_t millis() {																																	// Wraps like on the Arduino (uint32_t)
+		return (uint32_t)(gnMsup1Micros64() / 1000ull);
+	}
+
+	inline uint32_t micros() {
+		return (uint32_t)gnMsup1Micros64();
+	}
+
+	inline void delayMicroseconds(uint32_t us) {
+		if (us > 0) {
+			usleep(us);
+		}
+	}
+#endif
+#endif	// #ifndef gnMsup1Platform_h
@@ -0,0 +1,166 @@
+/*  GN Master Slave Universal Protocol Library
+ *  ==========================================
+ *
+ *  Library for generic Master/Slave Communications.
+ *
+ *  Register-Map (see gnMsup1RegisterMap.h).
+ *
+ *	MIT License
+ *
+ *	Copyright (c) 2018 Andreas Gloor
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+
+
+// Include necessary Library's
+#include "gnMsup1RegisterMap.h"
+
+
+
+// Write -> Copies into the Registers and marks just the Bytes which changed
+bool gnMsup1RegisterMap::write(uint16_t offset, const uint8_t data[], uint16_t length) {
+	if (offset > _size || length > _size - offset) {
+		return false;
+	}
+	
+	for (uint16_t i = 0; i < length; i++) {
+		uint16_t position = offset + i;
+		if (_registers[position] != data[i]) {
+			_registers[position] = data[i];
+			if (!bitRead(_dirty[position / 8], position % 8)) {
+				bitSet(_dirty[position / 8], position % 8);
+				_dirtyCount++;
+			}
+		}
+	}
+	return true;
+}
+
+
+
+// MarkDirty -> Sends the Span with the next Delta
+void gnMsup1RegisterMap::markDirty(uint16_t offset, uint16_t length) {
+	if (offset >= _size) {
+		return;
+	}
+	if (length > _size - offset) {
+		length = _size - offset;
+	}
+	
+	for (uint16_t position = offset; position < offset + length; position++) {
+		if (!bitRead(_dirty[position / 8], position % 8)) {
+			bitSet(_dirty[position / 8], position % 8);
+			_dirtyCount++;
+		}
+	}
+}
+
+
+
+// Pack -> Moves dirty Spans as Records into the Buffer and marks them clean
+uint8_t gnMsup1RegisterMap::pack(uint8_t buffer[], uint8_t capacity) {
+	uint8_t used = 0;
+	uint16_t position = 0;
+	
+	while (_dirtyCount > 0 && used + GNMSUP1_REGISTER_RECORDHEADER < capacity) {
+		uint16_t start = _nextDirty(position);
+		if (start >= _size) {
+			break;
+		}
+		
+		uint16_t limit = start + (capacity - used - GNMSUP1_REGISTER_RECORDHEADER);							// Span ends at the Buffer, the Map or a Gap worth a new Record
+		if (limit > _size) {
+			limit = _size;
+		}
+		uint16_t end = start + 1;
+		for (uint16_t i = end; i < limit && i - end < GNMSUP1_REGISTER_RECORDHEADER; i++) {
+			if (bitRead(_dirty[i / 8], i % 8)) {
+				end = i + 1;
+			}
+		}
+		
+		buffer[used++] = highByte(start);
+		buffer[used++] = lowByte(start);
+		buffer[used++] = end - start;
+		memcpy(&buffer[used], &_registers[start], end - start);
+		used += end - start;
+		for (uint16_t i = start; i < end; i++) {																									// Clean; merged Gap-Bytes weren't dirty
+			if (bitRead(_dirty[i / 8], i % 8)) {
+				bitClear(_dirty[i / 8], i % 8);
+				_dirtyCount--;
+			}
+		}
+		position = end;
+	}
+	return used;
+}
+
+
+
+// Apply -> Writes received Records into the Registers
+bool gnMsup1RegisterMap::apply(const uint8_t records[], uint8_t size) {
+	uint8_t position = 0;
+	uint16_t offset;
+	const uint8_t* data;
+	uint8_t length;
+	while (record(records, size, position, offset, data, length)) {
+		if (offset > _size || length > _size - offset) {
+			return false;
+		}
+		memcpy(&_registers[offset], data, length);
+	}
+	return position == size;
+}
+
+
+
+// Record -> Decodes the Record at the Position (bounds-checked) and advances the Position
+bool gnMsup1RegisterMap::record(const uint8_t records[], uint8_t size, uint8_t& position, uint16_t& offset, const uint8_t*& data, uint8_t& length) {
+	if (position + GNMSUP1_REGISTER_RECORDHEADER > size ||
+			position + GNMSUP1_REGISTER_RECORDHEADER + records[position + 2] > size) {
+		return false;
+	}
+	
+	offset = (records[position] << 8) | records[position + 1];
+	length = records[position + 2];
+	data = &records[position + GNMSUP1_REGISTER_RECORDHEADER];
+	position += GNMSUP1_REGISTER_RECORDHEADER + length;
+	return true;
+}
+
+
+
+// NextDirty -> First dirty Byte from the Offset on (skips clean Bitmap-Bytes at once); _size if none
+uint16_t gnMsup1RegisterMap::_nextDirty(uint16_t offset) {
+	while (offset < _size) {
+		uint8_t bits = _dirty[offset / 8] >> (offset % 8);
+		if (bits == 0) {
+			offset = (offset | 7) + 1;
+			continue;
+		}
+		while (!(bits & 0x01)) {
+			bits >>= 1;
+			offset++;
+		}
+		return offset < _size ? offset : _size;
+	}
+	return _size;
+}
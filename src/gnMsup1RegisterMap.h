@@ -0,0 +1,89 @@
+/*  GN Master Slave Universal Protocol Library
+ *  ==========================================
+ *
+ *  Library for generic Master/Slave Communications.
+ *
+ *  Register-Map: byte-addressable State-Table with a Dirty-Bit per Byte. Changed Spans get packed into Records
+ *  (Offset, Length, Data), so only the Delta goes over the Bus; several Spans share one Frame.
+ *
+ *	MIT License
+ *
+ *	Copyright (c) 2018 Andreas Gloor
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+
+
+ // Assure the Library gets loaded not more than once
+#ifndef gnMsup1RegisterMap_h
+#define gnMsup1RegisterMap_h
+
+
+
+// Include Config File -> Please just change Values in Config File, not here
+#include "config.h"
+
+
+
+// Internal defines
+#define GNMSUP1_REGISTER_RECORDHEADER				3																						// Record: Offset (16 Bit), Length, Data
+
+
+
+// Include necessary Library's
+#include "gnMsup1Platform.h"
+
+
+
+// Register-Map
+class gnMsup1RegisterMap {
+	public:
+		// Constructor - Uses the Caller's Registers (max. GNMSUP1_MAXREGISTERMAPSIZE Bytes); everything starts clean
+		gnMsup1RegisterMap(uint8_t registers[], uint16_t size) : _registers(registers), _size(size > GNMSUP1_MAXREGISTERMAPSIZE ? GNMSUP1_MAXREGISTERMAPSIZE : size) {};
+
+		// Registers - Direct Access; call markDirty() after writing them directly
+		uint8_t* registers() {return _registers;};
+		uint16_t size() {return _size;};
+
+		// Write - Copies into the Registers and marks just the Bytes which changed; false if out of Range
+		bool write(uint16_t offset, const uint8_t data[], uint16_t length);
+
+		// MarkDirty - Sends the Span with the next Delta, changed or not
+		void markDirty(uint16_t offset, uint16_t length);
+		bool dirty() {return _dirtyCount > 0;};
+
+		// Pack - Moves dirty Spans as Records into buffer (up to capacity Bytes) and marks them clean; returns the Bytes used.
+		//        Spans separated by less than a Record-Header get merged, that's cheaper than a second Record.
+		uint8_t pack(uint8_t buffer[], uint8_t capacity);
+
+		// Apply - Writes received Records into the Registers (without marking them dirty); returns false on a malformed Record
+		bool apply(const uint8_t records[], uint8_t size);
+
+		// Record - Decodes the Record at records[position] (bounds-checked); advances position, false at the End or if malformed
+		static bool record(const uint8_t records[], uint8_t size, uint8_t& position, uint16_t& offset, const uint8_t*& data, uint8_t& length);
+
+	private:
+		uint8_t*					_registers;
+		uint16_t					_size;
+		uint8_t						_dirty[(GNMSUP1_MAXREGISTERMAPSIZE + 7) / 8] = {};
+		uint16_t					_dirtyCount = 0;																						// Dirty Bytes
+		uint16_t _nextDirty(uint16_t offset);
+};
+#endif	// #ifndef gnMsup1RegisterMap_h
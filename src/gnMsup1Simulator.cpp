@@ -0,0 +1,334 @@
+/*  GN Master Slave Universal Protocol Library
+ *  ==========================================
+ *
+ *  Library for generic Master/Slave Communications.
+ *
+ *  Simulator (see gnMsup1Simulator.h).
+ *
+ *	MIT License
+ *
+ *	Copyright (c) 2018 Andreas Gloor
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+
+
+// Include necessary Library's
+#include "gnMsup1Simulator.h"
+
+#ifdef GNMSUP1_PLATFORM_POSIX
+#include <math.h>
+
+
+
+// Simulated Transport ///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+// RxArrived -> Bytes of the Receive-Queue already off the Line
+uint16_t gnMsup1SimulatedTransport::_rxArrived() {
+	uint16_t arrived = 0;
+	uint16_t index = _rxHead;
+	while (arrived < _rxCount && _rxArrival[index] <= _simulator->_now) {
+		arrived++;
+		index = (index + 1) % GNMSUP1_SIMULATOR_RXBUFFER;
+	}
+	return arrived;
+}
+
+
+
+// Begin -> Sets the Baudrate of the Node's UART; like reopening a Port, it drops the Receive-Queue
+bool gnMsup1SimulatedTransport::begin(uint32_t baudRate) {
+	if (!_simulator || baudRate == 0) {
+		return false;
+	}
+	_byteTime = 10000000000ull / baudRate;
+	_rxHead = 0;
+	_rxCount = 0;
+	return true;
+}
+
+
+
+// Available -> Bytes received up to now
+int gnMsup1SimulatedTransport::available() {
+	return _simulator ? _rxArrived() : 0;
+}
+
+
+
+// Read -> Copies the received Bytes; an empty Read within a blocking Wait lets the other Nodes run and the Clock advance
+size_t gnMsup1SimulatedTransport::read(uint8_t buffer[], size_t length) {
+	if (!_simulator) {
+		return 0;
+	}
+
+	size_t count = _rxArrived();
+	if (count > length) {
+		count = length;
+	}
+	for (size_t i = 0; i < count; i++) {
+		buffer[i] = _rxData[_rxHead];
+		_rxHead = (_rxHead + 1) % GNMSUP1_SIMULATOR_RXBUFFER;
+	}
+	_rxCount -= count;
+
+	if (count == 0 && ++_emptyReads > GNMSUP1_SIMULATOR_SPINREADS) {
+		_simulator->_idle(_node);
+	}
+	return count;
+}
+
+
+
+// Write -> Puts the Bytes on the Line
+size_t gnMsup1SimulatedTransport::write(const uint8_t buffer[], size_t length) {
+	if (!_simulator) {
+		return 0;
+	}
+	_simulator->_transmit(_node, buffer, length);
+	return length;
+}
+
+
+
+// Flush -> Waits (virtually) until the own Bytes left the Line
+void gnMsup1SimulatedTransport::flush() {
+	while (_simulator && _simulator->_now < _txEnd) {
+		_simulator->_idle(_node);
+	}
+}
+
+
+
+// TxComplete -> Own Bytes left the Line
+bool gnMsup1SimulatedTransport::txComplete() {
+	return !_simulator || _simulator->_now >= _txEnd;
+}
+
+
+
+// WaitInput -> Lets the other Nodes run until Input arrives or the Timeout passed (virtual Time)
+bool gnMsup1SimulatedTransport::waitInput(uint32_t timeoutMs) {
+	if (!_simulator) {
+		return false;
+	}
+	uint64_t end = _simulator->_now + (uint64_t)timeoutMs * 1000000ull;
+	while (_rxArrived() == 0) {
+		if (timeoutMs != GNMSUP1_NODEADLINE && _simulator->_now >= end) {
+			return false;
+		}
+		_simulator->_idle(_node);
+	}
+	return true;
+}
+
+
+
+// Simulator /////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+// Constructor -> Installs the virtual Clock
+gnMsup1Simulator::gnMsup1Simulator(uint32_t baudRate, double bitErrorRate, uint32_t seed) {
+	_byteTime = 10000000000ull / baudRate;
+	double byteErrorRate = 1.0 - pow(1.0 - bitErrorRate, 10);																		// Any of the 10 Bits on the Wire
+	_byteErrorThreshold = (byteErrorRate >= 1.0) ? 0xFFFFFFFFul : (uint32_t)(byteErrorRate * 4294967296.0);
+	_random = seed ? seed : 1;
+
+	gnMsup1Clock().micros = _clock;
+	gnMsup1Clock().context = this;
+}
+
+
+
+// Destructor -> Back to the Monotonic Clock
+gnMsup1Simulator::~gnMsup1Simulator() {
+	if (gnMsup1Clock().context == this) {
+		gnMsup1Clock().micros = nullptr;
+		gnMsup1Clock().context = nullptr;
+	}
+}
+
+
+
+// Attach -> Adds a Node and connects its Transport to the Line
+int gnMsup1Simulator::_attach(void* bus, StepFunction step, gnMsup1SimulatedTransport* transport) {
+	if (_nodeCount >= GNMSUP1_SIMULATOR_MAXNODES || transport->_simulator) {
+		return -1;
+	}
+
+	_node_t& node = _nodes[_nodeCount];
+	node.bus = bus;
+	node.step = step;
+	node.transport = transport;
+	node.busy = false;
+	node.deadline = _now;
+	transport->_simulator = this;
+	transport->_node = _nodeCount;
+	transport->_byteTime = _byteTime;
+	return _nodeCount++;
+}
+
+
+
+// Run -> Passes over the Nodes until the virtual Clock reached the End
+void gnMsup1Simulator::run(uint64_t durationMicros) {
+	uint64_t end = _now + durationMicros * 1000ull;
+	while (_now < end) {
+		for (uint8_t i = 0; i < _nodeCount; i++) {
+			if (!_nodes[i].busy) {
+				_stepNode(i);
+			}
+		}
+		_advance(end);
+	}
+}
+
+
+
+// Utilisation -> Line busy Time per elapsed Time
+double gnMsup1Simulator::utilisation() {
+	return (_now > _statisticsStart) ? (double)_lineBusy / (double)(_now - _statisticsStart) : 0.0;
+}
+
+
+
+// ResetStatistics -> Restarts the Line-Statistics now
+void gnMsup1Simulator::resetStatistics() {
+	_statisticsStart = _now;
+	_lineBusy = 0;
+	_lineBytes = 0;
+	_collisions = 0;
+	_baudMismatches = 0;
+	_bitErrors = 0;
+	_rxOverflows = 0;
+}
+
+
+
+// StepNode -> One handleCommunication() of a Node; keeps its next Deadline
+void gnMsup1Simulator::_stepNode(uint8_t node) {
+	_node_t& entry = _nodes[node];
+	entry.busy = true;
+	entry.transport->_emptyReads = 0;
+	uint32_t deadline = entry.step(entry.bus);
+	entry.busy = false;
+	entry.deadline = (deadline == GNMSUP1_NODEADLINE) ? UINT64_MAX : (_now / 1000ull + deadline) * 1000ull;				// micros() of the Node reaches it
+}
+
+
+
+// Idle -> A Node waits inside its Step: the other Nodes run once, then the Clock advances
+void gnMsup1Simulator::_idle(uint8_t node) {
+	for (uint8_t i = 0; i < _nodeCount; i++) {
+		if (i != node && !_nodes[i].busy) {
+			_stepNode(i);
+		}
+	}
+	_advance(_now + 1000000ull);																																// A waiting Node doesn't tell its Deadline: at most 1 ms
+}
+
+
+
+// Advance -> Moves the Clock to the next Event (Byte-Arrival, Line free, Deadline of an idle Node), at least by the Processing-Time
+void gnMsup1Simulator::_advance(uint64_t limit) {
+	uint64_t next = limit;
+	if (_lineFree > _now && _lineFree < next) {
+		next = _lineFree;
+	}
+	for (uint8_t i = 0; i < _nodeCount; i++) {
+		gnMsup1SimulatedTransport* transport = _nodes[i].transport;
+		if (transport->_rxCount > 0 && transport->_rxArrival[transport->_rxHead] < next) {					// Queue in Order of Arrival: the Head is the next one
+			next = transport->_rxArrival[transport->_rxHead];
+		}
+		if (!_nodes[i].busy && _nodes[i].deadline < next) {
+			next = _nodes[i].deadline;
+		}
+	}
+
+	if (next < _now + _processing) {
+		next = _now + _processing;
+	}
+	if (next > limit) {
+		next = limit;
+	}
+	if (next > _now) {
+		_now = next;
+	}
+}
+
+
+
+// Transmit -> Serializes the Bytes on the Line (at the Baudrate of the Sender) and queues them at every other Node (with Bit-Errors,
+//             Collisions and Baudrate-Mismatches)
+void gnMsup1Simulator::_transmit(uint8_t sender, const uint8_t buffer[], size_t length) {
+	uint64_t byteTime = _nodes[sender].transport->_byteTime;
+	for (size_t i = 0; i < length; i++) {
+		uint8_t value = buffer[i];
+		if (_lineOwner != sender && _lineFree > _now) {																						// Another Driver is still active: the Byte gets garbled
+			value ^= 0xFF;
+			_collisions++;
+		}
+		if (_byteErrorThreshold && _nextRandom() < _byteErrorThreshold) {
+			value ^= 1 << (_nextRandom() % 8);
+			_bitErrors++;
+		}
+
+		uint64_t start = (_lineFree > _now) ? _lineFree : _now;
+		_lineFree = start + byteTime;
+		_lineOwner = sender;
+		_lineBusy += byteTime;
+		_lineBytes++;
+
+		for (uint8_t n = 0; n < _nodeCount; n++) {
+			if (n == sender) {
+				continue;
+			}
+			gnMsup1SimulatedTransport* receiver = _nodes[n].transport;
+			if (receiver->_rxCount == GNMSUP1_SIMULATOR_RXBUFFER) {
+				_rxOverflows++;
+				continue;
+			}
+			uint16_t slot = (receiver->_rxHead + receiver->_rxCount) % GNMSUP1_SIMULATOR_RXBUFFER;
+			receiver->_rxArrival[slot] = _lineFree;
+			if (receiver->_byteTime != byteTime) {																										// UART at another Rate samples Garbage
+				receiver->_rxData[slot] = (uint8_t)_nextRandom();
+				_baudMismatches++;
+			} else {
+				receiver->_rxData[slot] = value;
+			}
+			receiver->_rxCount++;
+		}
+	}
+	_nodes[sender].transport->_txEnd = _lineFree;
+}
+
+
+
+// NextRandom -> Xorshift32 (reproducible per Seed)
+uint32_t gnMsup1Simulator::_nextRandom() {
+	_random ^= _random << 13;
+	_random ^= _random >> 17;
+	_random ^= _random << 5;
+	return _random;
+}
+#endif	// #ifdef GNMSUP1_PLATFORM_POSIX
@@ -0,0 +1,162 @@
+/*  GN Master Slave Universal Protocol Library
+ *  ==========================================
+ *
+ *  Library for generic Master/Slave Communications.
+ *
+ *  Simulator (POSIX Host): a virtual half-duplex RS485 Line with a virtual Clock. One Master and up to
+ *  GNMSUP1_SIMULATOR_MAXNODES - 1 Slaves run in one Thread, each with a gnMsup1SimulatedTransport; the Line delivers every
+ *  Byte to the other Nodes after its Time on the Wire (Baudrate), flips Bits at the configured Bit-Error-Rate and garbles
+ *  Bytes of two Nodes driving at once (or received at another Baudrate than sent). Meant to measure Blocking-Modes, Timeouts and Engines without Hardware.
+ *
+ *	MIT License
+ *
+ *	Copyright (c) 2018 Andreas Gloor
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+
+
+ // Assure the Library gets loaded not more than once
+#ifndef gnMsup1Simulator_h
+#define gnMsup1Simulator_h
+
+
+
+// Include Config File -> Please just change Values in Config File, not here
+#include "config.h"
+
+
+
+// Include necessary Library's
+#include "gnMsup1Platform.h"
+#include "gnMsup1Transport.h"
+
+#ifdef GNMSUP1_PLATFORM_POSIX
+class gnMsup1Simulator;
+
+
+
+// Transport of a Node on the simulated Line
+class gnMsup1SimulatedTransport : public gnMsup1Transport {
+	friend class gnMsup1Simulator;
+
+	public:
+		gnMsup1SimulatedTransport() {};
+
+		bool begin(uint32_t baudRate);
+		int available();
+		size_t read(uint8_t buffer[], size_t length);
+		size_t write(const uint8_t buffer[], size_t length);
+		void flush();
+		bool txComplete();
+		void setDriverEnable(bool) {};
+		bool waitInput(uint32_t timeoutMs);
+
+	private:
+		gnMsup1Simulator*	_simulator = nullptr;
+		uint8_t						_node = 0;
+		uint64_t					_txEnd = 0;																								// Own last Byte leaves the Line (Nanoseconds)
+		uint64_t					_byteTime = 0;																						// UART of this Node (begin); Bytes of another Rate arrive garbled
+		uint8_t						_emptyReads = 0;																					// Reads without Data in the current Step; many of them = a blocking Wait
+
+		// Receive-Queue: Bytes with their Arrival-Time, in Order of Arrival
+		uint64_t					_rxArrival[GNMSUP1_SIMULATOR_RXBUFFER];
+		uint8_t						_rxData[GNMSUP1_SIMULATOR_RXBUFFER];
+		uint16_t					_rxHead = 0;
+		uint16_t					_rxCount = 0;
+		uint16_t _rxArrived();
+};
+
+
+
+// Simulated Line and virtual Clock; construct it before the Buses (they read the Clock when constructed). One per Process.
+class gnMsup1Simulator {
+	friend class gnMsup1SimulatedTransport;
+
+	public:
+		gnMsup1Simulator(uint32_t baudRate, double bitErrorRate = 0, uint32_t seed = 1);
+		~gnMsup1Simulator();
+
+		// Attach - Adds a Node (any gnMsup1Bus) with its Transport; call before begin() of the Bus. Returns the Node-Index, -1 if full
+		template <class Bus> int attach(Bus& bus, gnMsup1SimulatedTransport& transport) {
+			return _attach(&bus, &_step<Bus>, &transport);
+		}
+
+		// Run - Advances the virtual Clock by durationMicros: every Node runs handleCommunication() once per Pass, then the Clock jumps
+		//       to the next Byte-Arrival or nextDeadlineMicros() of a Node. Blocking Waits inside a Node let the other Nodes run meanwhile.
+		void run(uint64_t durationMicros);
+		uint64_t now() {return _now / 1000;};																										// Virtual Microseconds (micros()/millis() of the Nodes)
+
+		// ProcessingTime - Virtual Time a Pass costs at least (CPU-Time of the Nodes); Default GNMSUP1_SIMULATOR_PROCESSINGMICROS
+		void processingTime(uint32_t micros) {_processing = (uint64_t)micros * 1000;};
+
+		// Line-Statistics since Construction or resetStatistics()
+		uint64_t lineBytes() {return _lineBytes;};
+		uint64_t collisions() {return _collisions;};																						// Bytes garbled by two Drivers at once
+		uint64_t baudMismatches() {return _baudMismatches;};																		// Bytes garbled by a Receiver at another Baudrate
+		uint64_t bitErrors() {return _bitErrors;};
+		uint64_t rxOverflows() {return _rxOverflows;};																					// Bytes lost in a full Receive-Queue
+		double utilisation();																																		// Share of the Time the Line carried a Byte
+		void resetStatistics();
+
+	private:
+		typedef uint32_t (*StepFunction) (void* bus);																							// handleCommunication(); returns the next Deadline of the Bus (Microseconds)
+		template <class Bus> static uint32_t _step(void* bus) {
+			Bus* instance = static_cast<Bus*>(bus);
+			instance->handleCommunication();
+			return instance->nextDeadlineMicros();
+		}
+
+		struct						_node_t {
+												void*												bus;
+												StepFunction								step;
+												gnMsup1SimulatedTransport*	transport;
+												bool												busy;												// Inside its Step (maybe a blocking Wait)
+												uint64_t										deadline;										// Next Step due (Nanoseconds), after the last Step
+											};
+		_node_t						_nodes[GNMSUP1_SIMULATOR_MAXNODES];
+		uint8_t						_nodeCount = 0;
+
+		uint64_t					_now = 0;																									// Virtual Clock (Nanoseconds)
+		uint64_t					_processing = (uint64_t)GNMSUP1_SIMULATOR_PROCESSINGMICROS * 1000;
+		uint64_t					_byteTime;																								// Start-, 8 Data-, Stop-Bit (Nanoseconds) at the Baudrate of the Constructor
+		uint32_t					_byteErrorThreshold;																			// Random-Value below: the Byte gets a Bit-Error
+		uint32_t					_random;																									// Xorshift32 State
+		uint64_t					_lineFree = 0;																						// Last Byte leaves the Line
+		int16_t						_lineOwner = -1;																					// Node driving the Line till then
+
+		uint64_t					_statisticsStart = 0;
+		uint64_t					_lineBusy = 0;
+		uint64_t					_lineBytes = 0;
+		uint64_t					_collisions = 0;
+		uint64_t					_baudMismatches = 0;
+		uint64_t					_bitErrors = 0;
+		uint64_t					_rxOverflows = 0;
+
+		static uint64_t _clock(void* simulator) {return static_cast<gnMsup1Simulator*>(simulator)->now();};
+		int _attach(void* bus, StepFunction step, gnMsup1SimulatedTransport* transport);
+		void _stepNode(uint8_t node);
+		void _idle(uint8_t node);
+		void _advance(uint64_t limit);
+		void _transmit(uint8_t sender, const uint8_t buffer[], size_t length);
+		uint32_t _nextRandom();
+};
+#endif	// #ifdef GNMSUP1_PLATFORM_POSIX
+#endif	// #ifndef gnMsup1Simulator_h
@@ -0,0 +1,144 @@
+/*  GN Master Slave Universal Protocol Library
+ *  ==========================================
+ *
+ *  Library for generic Master/Slave Communications.
+ *
+ *  Timer-Service: one Timestamp per handleCommunication() Pass, shared by all Protocol-Deadlines. Deadlines run in
+ *  Microseconds and compare by unsigned Differences (wraparound-safe); a Deadline latches its Expiry, so an old Timestamp
+ *  never comes alive again after micros() wrapped (~71 Minutes).
+ *
+ *	MIT License
+ *
+ *	Copyright (c) 2018 Andreas Gloor
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+
+
+ // Assure the Library gets loaded not more than once
+#ifndef gnMsup1Timer_h
+#define gnMsup1Timer_h
+
+
+
+// Include Config File -> Please just change Values in Config File, not here
+#include "config.h"
+
+
+
+// Include necessary Library's
+#include "gnMsup1Platform.h"
+#include "gnMsup1Transport.h"
+
+
+
+// Timer - Cached Timestamp of the current Pass; refresh() at the Start of a Pass and whenever Control returns from the Line or User-Code
+class gnMsup1Timer {
+	public:
+		void refresh() {_micros = ::micros(); _millis = ::millis();};
+		uint32_t micros() {return _micros;};
+		uint32_t millis() {return _millis;};																												// Long Intervals (Push-Queue, Scavenging, Scheduler-Floor)
+		
+		// Remaining - Time left of a Period started at since (same Unit as now); 0 once passed
+		static uint32_t remaining(uint32_t now, uint32_t since, uint32_t period) {
+			return (now - since < period) ? period - (now - since) : 0;
+		};
+	
+	private:
+		uint32_t					_micros = 0;
+		uint32_t					_millis = 0;
+};
+
+
+
+// Deadline - One-Shot Timeout in Microseconds on a gnMsup1Timer (Periods below 2^31 us)
+class gnMsup1Deadline {
+	public:
+		void arm(gnMsup1Timer& timer, uint32_t periodMicros) {_start = timer.micros(); _period = periodMicros; _armed = true;};
+		void disarm() {_armed = false;};
+		uint32_t start() {return _start;};
+		uint32_t period() {return _period;};
+		
+		// Running - True until the Period passed; then disarms itself (Expiry latched)
+		bool running(gnMsup1Timer& timer) {
+			if (_armed && timer.micros() - _start >= _period) {
+				_armed = false;
+			}
+			return _armed;
+		};
+		
+		// Remaining - Microseconds left; 0 once passed, GNMSUP1_NODEADLINE if not armed
+		uint32_t remaining(gnMsup1Timer& timer) {
+			return _armed ? gnMsup1Timer::remaining(timer.micros(), _start, _period) : GNMSUP1_NODEADLINE;
+		};
+	
+	private:
+		uint32_t					_start = 0;
+		uint32_t					_period = 0;
+		bool							_armed = false;
+};
+
+
+// RttEstimator - Smoothed Turnaround of a Peer and its Deviation in Microseconds, like the TCP Retransmission-Timeout (RFC 6298):
+//                Timeout = Srtt + 4 * Deviation within Floor and Ceiling; the Ceiling until GNMSUP1_ADAPTIVESAMPLES Samples arrived. 5 Bytes
+class gnMsup1RttEstimator {
+	public:
+		void sample(uint32_t micros) {
+			uint16_t value = (micros > 0xFFFF) ? 0xFFFF : micros;
+			if (_samples < 0xFF) {
+				_samples++;
+			}
+			if (!_srtt) {																																					// First Sample
+				_srtt = value ? value : 1;
+				_deviation = value / 2;
+				return;
+			}
+			uint16_t error = (value > _srtt) ? value - _srtt : _srtt - value;
+			_deviation = _deviation - _deviation / 4 + error / 4;																	// Gains 1/4 and 1/8 (Shifts on AVR)
+			_srtt = _srtt - _srtt / 8 + value / 8;
+		};
+		
+		// Backoff - Timeout or late Answer: raises the Deviation so the Timeout about doubles, until Samples pull it back
+		void backoff() {
+			uint32_t deviation = 2ul * _deviation + _srtt / 4 + 1;
+			_deviation = (deviation > 0xFFFF) ? 0xFFFF : deviation;
+		};
+		
+		uint32_t timeout(uint32_t floor, uint32_t ceiling) {
+			if (!learned()) {
+				return ceiling;
+			}
+			uint32_t timeout = (uint32_t)_srtt + 4ul * _deviation;
+			if (timeout < floor) {
+				timeout = floor;
+			}
+			return (timeout < ceiling) ? timeout : ceiling;
+		};
+		bool learned() {return _samples >= GNMSUP1_ADAPTIVESAMPLES;};
+		uint16_t srtt() {return _srtt;};
+		uint16_t deviation() {return _deviation;};
+		void reset() {_srtt = 0; _deviation = 0; _samples = 0;};
+	
+	private:
+		uint16_t					_srtt = 0;																									// 0 = no Sample yet
+		uint16_t					_deviation = 0;
+		uint8_t						_samples = 0;
+};
+#endif	// #ifndef gnMsup1Timer_h
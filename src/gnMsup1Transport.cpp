@@ -0,0 +1,389 @@
+/*  GN Master Slave Universal Protocol Library
+ *  ==========================================
+ *
+ *  Library for generic Master/Slave Communications.
+ *
+ *  Transport-Layer Backends (see gnMsup1Transport.h).
+ *
+ *	MIT License
+ *
+ *	Copyright (c) 2018 Andreas Gloor
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+
+
+// Include necessary Library's
+#include "gnMsup1Transport.h"
+
+#ifdef GNMSUP1_PLATFORM_POSIX
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <limits.h>
+	#include <poll.h>
+	#include <stdlib.h>
+	#include <termios.h>
+	#include <sys/ioctl.h>
+	#ifdef __linux__
+		#include <linux/serial.h>
+	#endif
+#endif
+
+
+
+// WaitInput -> Spins until Input arrives or the Timeout passed (Transports without a Way to sleep)
+bool gnMsup1Transport::waitInput(uint32_t timeoutMs) {
+	uint32_t start = millis();
+	while (available() <= 0) {
+		if (timeoutMs != GNMSUP1_NODEADLINE && millis() - start >= timeoutMs) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+
+#ifdef GNMSUP1_PLATFORM_ARDUINO
+// Stream Transport //////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+// Begin -> Call Begin Function of corresponding SerialObject and initialize the DE-Pin
+bool gnMsup1StreamTransport::begin(uint32_t baudRate) {
+	if (!_stream) {
+		return false;
+	}
+
+	if (_hwStream) {
+		_hwStream->begin(baudRate);
+	} else {
+		_swStream->begin(baudRate);
+	}
+
+	pinMode(_rs485DePin, OUTPUT);
+	digitalWrite(_rs485DePin, LOW);
+	_byteMicros = (10000000ul + baudRate - 1) / baudRate;
+	_txIdleMicros = micros();
+	return true;
+}
+
+
+
+// Read -> Copies the available Bytes (max. length) without blocking
+size_t gnMsup1StreamTransport::read(uint8_t buffer[], size_t length) {
+	size_t count = 0;
+	while (count < length && _stream->available()) {
+		buffer[count++] = _stream->read();
+	}
+	return count;
+}
+
+
+
+// Write -> Queues the Bytes and advances the estimated End of Transmission (the UART sends them back to back)
+size_t gnMsup1StreamTransport::write(const uint8_t buffer[], size_t length) {
+	size_t written = _stream->write(buffer, length);
+	uint32_t now = micros();																																	// A full Tx-Buffer blocks the Write: count from its Return (errs late, never early)
+	if ((int32_t)(now - _txIdleMicros) > 0) {																									// Line was idle; Transmission starts now
+		_txIdleMicros = now;
+	}
+	_txIdleMicros += written * _byteMicros;
+	return written;
+}
+
+
+
+// SetDriverEnable -> Set or release DE for RS485
+void gnMsup1StreamTransport::setDriverEnable(bool enable) {
+	digitalWrite(_rs485DePin, enable ? HIGH : LOW);
+	if (enable) {
+		delayMicroseconds(GNMSUP1_RS485_DEENABLEWAITMICROS);
+	}
+}
+#endif	// #ifdef GNMSUP1_PLATFORM_ARDUINO
+
+
+
+#ifdef GNMSUP1_PLATFORM_POSIX
+// POSIX Transport ///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+// Destructor -> Close the Port
+gnMsup1PosixTransport::~gnMsup1PosixTransport() {
+	if (_fd >= 0) {
+		close(_fd);
+	}
+}
+
+
+
+// Begin -> Open the Device non-blocking and configure it
+bool gnMsup1PosixTransport::begin(uint32_t baudRate) {
+	if (_fd < 0) {
+		_fd = open(_device, O_RDWR | O_NOCTTY | O_NONBLOCK);
+		if (_fd < 0) {
+			return false;
+		}
+	}
+	return _configure(baudRate);
+}
+
+
+
+// Available -> Bytes in the Bulk-Buffer; refills it when drained
+int gnMsup1PosixTransport::available() {
+	if (_rxHead == _rxTail) {
+		_fillRxBuffer();
+	}
+	return _rxTail - _rxHead;
+}
+
+
+
+// Read -> Serves from the Bulk-Buffer first, then reads the Remainder directly from the Device
+size_t gnMsup1PosixTransport::read(uint8_t buffer[], size_t length) {
+	size_t count = _rxTail - _rxHead;
+	if (count > length) {
+		count = length;
+	}
+	memcpy(buffer, &_rxBuffer[_rxHead], count);
+	_rxHead += count;
+
+	if (count < length && _fd >= 0) {
+		ssize_t direct = ::read(_fd, &buffer[count], length - count);
+		if (direct > 0) {
+			count += direct;
+		}
+	}
+	return count;
+}
+
+
+
+// Write -> Writes all Bytes; waits for the Device if the Kernel-Buffer is full
+size_t gnMsup1PosixTransport::write(const uint8_t buffer[], size_t length) {
+	size_t written = 0;
+	while (written < length && _fd >= 0) {
+		ssize_t result = ::write(_fd, &buffer[written], length - written);
+		if (result > 0) {
+			written += result;
+		} else if (result < 0 && errno == EAGAIN) {																							// Kernel-Buffer full: sleep until it drained
+			struct pollfd descriptor;
+			descriptor.fd = _fd;
+			descriptor.events = POLLOUT;
+			descriptor.revents = 0;
+			if (::poll(&descriptor, 1, -1) < 0 && errno != EINTR) {
+				break;
+			}
+		} else if (result < 0 && errno != EINTR) {
+			break;
+		}
+	}
+	return written;
+}
+
+
+
+// Flush -> Waits until the Output is transmitted
+void gnMsup1PosixTransport::flush() {
+	if (_fd >= 0) {
+		tcdrain(_fd);
+	}
+}
+
+
+
+// WaitInput -> Sleeps in poll() until the Device has Input or the Timeout passed; the Bulk-Buffer counts as Input.
+//              A Hang-up or Error (e.g. Pty without Peer) is no Input: sleep up to GNMSUP1_POSIX_HANGUPRETRY instead of returning at once
+bool gnMsup1PosixTransport::waitInput(uint32_t timeoutMs) {
+	if (_rxHead < _rxTail) {
+		return true;
+	}
+	if (_fd < 0) {
+		return false;
+	}
+
+	struct pollfd descriptor;
+	descriptor.fd = _fd;
+	descriptor.events = POLLIN;
+	int timeout = (timeoutMs == GNMSUP1_NODEADLINE) ? -1 : (timeoutMs > INT_MAX ? INT_MAX : (int)timeoutMs);
+	if (::poll(&descriptor, 1, timeout) <= 0) {
+		return false;
+	}
+	if (descriptor.revents & POLLIN) {
+		return true;
+	}
+	::poll(nullptr, 0, (timeout < 0 || timeout > GNMSUP1_POSIX_HANGUPRETRY) ? GNMSUP1_POSIX_HANGUPRETRY : timeout);
+	return false;
+}
+
+
+
+// TxComplete -> Checks the Transmitter-Shift-Register (UART) or the Output-Queue (other Devices, e.g. Pseudo-Terminals)
+bool gnMsup1PosixTransport::txComplete() {
+	if (_fd < 0) {
+		return true;
+	}
+
+	#ifdef TIOCSERGETLSR
+		unsigned int lsr;
+		if (ioctl(_fd, TIOCSERGETLSR, &lsr) == 0) {
+			return lsr & TIOCSER_TEMT;
+		}
+	#endif
+	int queued;
+	if (ioctl(_fd, TIOCOUTQ, &queued) == 0) {
+		return queued == 0;
+	}
+	tcdrain(_fd);
+	return true;
+}
+
+
+
+// SetDriverEnable -> Drive RTS; with DirectionKernelRs485 the Driver toggles RTS itself
+void gnMsup1PosixTransport::setDriverEnable(bool enable) {
+	if (_directionControl == DirectionRts && _fd >= 0) {
+		int rts = TIOCM_RTS;
+		ioctl(_fd, enable ? TIOCMBIS : TIOCMBIC, &rts);
+		if (enable) {
+			delayMicroseconds(GNMSUP1_RS485_DEENABLEWAITMICROS);
+		}
+	}
+}
+
+
+
+// Configure -> Raw Mode 8N1, Baudrate and Direction-Control
+bool gnMsup1PosixTransport::_configure(uint32_t baudRate) {
+	speed_t speed;
+	switch (baudRate) {
+		case 1200:		speed = B1200;		break;
+		case 2400:		speed = B2400;		break;
+		case 4800:		speed = B4800;		break;
+		case 9600:		speed = B9600;		break;
+		case 19200:		speed = B19200;		break;
+		case 38400:		speed = B38400;		break;
+		case 57600:		speed = B57600;		break;
+		case 115200:	speed = B115200;	break;
+		case 230400:	speed = B230400;	break;
+		#ifdef B460800
+		case 460800:	speed = B460800;	break;
+		#endif
+		#ifdef B500000
+		case 500000:	speed = B500000;	break;
+		#endif
+		#ifdef B921600
+		case 921600:	speed = B921600;	break;
+		#endif
+		#ifdef B1000000
+		case 1000000:	speed = B1000000;	break;
+		#endif
+		default:
+			return false;
+	}
+
+	struct termios options;
+	if (tcgetattr(_fd, &options) != 0) {
+		return false;
+	}
+	cfmakeraw(&options);
+	options.c_cflag |= (CLOCAL | CREAD);
+	options.c_cflag &= ~(CSTOPB | CRTSCTS);
+	options.c_cc[VMIN] = 0;
+	options.c_cc[VTIME] = 0;
+	cfsetispeed(&options, speed);
+	cfsetospeed(&options, speed);
+	if (tcsetattr(_fd, TCSANOW, &options) != 0) {
+		return false;
+	}
+	tcflush(_fd, TCIOFLUSH);
+
+	#ifdef TIOCSRS485
+	if (_directionControl == DirectionKernelRs485) {																							// Let the Driver toggle RTS around every Transmission
+		struct serial_rs485 rs485;
+		memset(&rs485, 0, sizeof(rs485));
+		rs485.flags = SER_RS485_ENABLED | SER_RS485_RTS_ON_SEND;
+		rs485.delay_rts_before_send = 0;
+		rs485.delay_rts_after_send = 0;
+		if (ioctl(_fd, TIOCSRS485, &rs485) != 0) {
+			_directionControl = DirectionRts;																												// Driver without RS485 Support: fall back to manual RTS
+		}
+	}
+	#else
+	if (_directionControl == DirectionKernelRs485) {
+		_directionControl = DirectionRts;
+	}
+	#endif
+
+	setDriverEnable(false);
+	return true;
+}
+
+
+
+// FillRxBuffer -> One non-blocking read() into the Bulk-Buffer
+size_t gnMsup1PosixTransport::_fillRxBuffer() {
+	_rxHead = 0;
+	_rxTail = 0;
+	if (_fd < 0) {
+		return 0;
+	}
+	ssize_t result = ::read(_fd, _rxBuffer, sizeof(_rxBuffer));
+	if (result > 0) {
+		_rxTail = result;
+	}
+	return _rxTail;
+}
+
+
+
+// Pty Transport /////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+// Begin -> Create the Pseudo-Terminal (Master Side)
+bool gnMsup1PtyTransport::begin(uint32_t baudRate) {
+	if (_fd < 0) {
+		_fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+		if (_fd < 0) {
+			return false;
+		}
+		if (grantpt(_fd) != 0 || unlockpt(_fd) != 0) {
+			close(_fd);
+			_fd = -1;
+			return false;
+		}
+	}
+	return _configure(baudRate);
+}
+
+
+
+// PeerName -> Device-Path of the other End (valid after begin)
+const char* gnMsup1PtyTransport::peerName() {
+	if (_fd < 0 || ptsname_r(_fd, _peerName, sizeof(_peerName)) != 0) {
+		return nullptr;
+	}
+	return _peerName;
+}
+#endif	// #ifdef GNMSUP1_PLATFORM_POSIX
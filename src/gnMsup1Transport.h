@@ -0,0 +1,173 @@
+/*  GN Master Slave Universal Protocol Library
+ *  ==========================================
+ *
+ *  Library for generic Master/Slave Communications.
+ *
+ *  Transport-Layer: Byte-I/O, Direction-Control (RS485 DE / RTS), Flush and Available behind one Interface.
+ *  Backends:
+ *    - gnMsup1StreamTransport	Arduino HardwareSerial or SoftwareSerial with a RS485 DE-Pin
+ *    - gnMsup1PosixTransport		POSIX termios Device (Linux Gateway), Direction by RTS or TIOCSRS485
+ *    - gnMsup1PtyTransport			Pseudo-Terminal Loopback, to run Master and Slave on a plain Host at full Speed
+ *
+ *	MIT License
+ *
+ *	Copyright (c) 2018 Andreas Gloor
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+
+
+ // Assure the Library gets loaded not more than once
+#ifndef gnMsup1Transport_h
+#define gnMsup1Transport_h
+
+
+
+// Include Config File -> Please just change Values in Config File, not here
+#include "config.h"
+
+
+
+// Internal defines
+#define GNMSUP1_RS485_DEENABLEWAITMICROS		0
+#define GNMSUP1_NODEADLINE									0xFFFFFFFFul															// No Timer running: only Input wakes the Bus
+
+
+
+// Include necessary Library's
+#include "gnMsup1Platform.h"
+
+#ifdef GNMSUP1_PLATFORM_ARDUINO
+	#include <HardwareSerial.h>
+	#include <SoftwareSerial.h>
+	#include <Stream.h>
+#endif
+
+
+
+// Transport Interface
+class gnMsup1Transport {
+	public:
+		virtual ~gnMsup1Transport() {}
+
+		// Begin - Open/Configure the Port
+		virtual bool begin(uint32_t baudRate) = 0;
+
+		// Byte-I/O - Read never blocks and returns the Count of Bytes copied; Write queues the Bytes for Transmission
+		virtual int available() = 0;
+		virtual size_t read(uint8_t buffer[], size_t length) = 0;
+		virtual size_t write(const uint8_t buffer[], size_t length) = 0;
+		size_t write(uint8_t value) {return write(&value, 1);};
+
+		// Flush - Waits until every written Byte left the Line
+		virtual void flush() = 0;
+
+		// TxComplete - True once every written Byte left the Line, without waiting (non-blocking Transmit-Path); falls back to flush()
+		virtual bool txComplete() {flush(); return true;};
+
+		// WaitInput - Blocks until Input is available or timeoutMs passed (GNMSUP1_NODEADLINE: no Timeout); true if Input is available.
+		//             Spins on available() by default; Transports with a File Descriptor sleep in the Kernel
+		virtual bool waitInput(uint32_t timeoutMs);
+
+		// SetDriverEnable - Takes (true) or releases (false) the Bus; RS485 DE-Pin or RTS
+		virtual void setDriverEnable(bool enable) = 0;
+};
+
+
+
+#ifdef GNMSUP1_PLATFORM_ARDUINO
+// Arduino Stream Transport (HardwareSerial or SoftwareSerial with a RS485 DE-Pin)
+class gnMsup1StreamTransport : public gnMsup1Transport {
+	public:
+		gnMsup1StreamTransport() {};
+		gnMsup1StreamTransport(HardwareSerial& device, uint8_t rs485DePin) : _hwStream(&device), _stream(&device), _rs485DePin(rs485DePin) {};
+		gnMsup1StreamTransport(SoftwareSerial& device, uint8_t rs485DePin) : _swStream(&device), _stream(&device), _rs485DePin(rs485DePin) {};
+
+		bool begin(uint32_t baudRate);
+		int available() {return _stream->available();};
+		size_t read(uint8_t buffer[], size_t length);
+		size_t write(const uint8_t buffer[], size_t length);
+		void flush() {_stream->flush();};
+		bool txComplete() {return (int32_t)(micros() - _txIdleMicros - _byteMicros) >= 0;};										// One Byte of Margin: the Shift-Register may still hold the Stop-Bit
+		void setDriverEnable(bool enable);
+
+	private:
+		HardwareSerial*		_hwStream = nullptr;
+		SoftwareSerial*		_swStream = nullptr;
+		Stream*						_stream = nullptr;
+		uint8_t						_rs485DePin = 0;
+		uint32_t					_byteMicros = 0;																					// Time on the Line per Byte (Start-, 8 Data-, Stop-Bit)
+		uint32_t					_txIdleMicros = 0;																				// Estimated End of the last queued Byte (from the Return of write())
+};
+#endif
+
+
+
+#ifdef GNMSUP1_PLATFORM_POSIX
+// POSIX termios Transport (Linux Gateway)
+class gnMsup1PosixTransport : public gnMsup1Transport {
+	public:
+		enum DirectionControl	{DirectionNone, DirectionRts, DirectionKernelRs485};
+
+		gnMsup1PosixTransport(const char* device, gnMsup1PosixTransport::DirectionControl directionControl = DirectionKernelRs485) : _device(device), _directionControl(directionControl) {};
+		virtual ~gnMsup1PosixTransport();
+
+		bool begin(uint32_t baudRate);
+		int available();
+		size_t read(uint8_t buffer[], size_t length);
+		size_t write(const uint8_t buffer[], size_t length);
+		void flush();
+		bool txComplete();
+		void setDriverEnable(bool enable);
+		bool waitInput(uint32_t timeoutMs);
+
+		// Fd - The File Descriptor of the opened Port (-1 before begin)
+		int fd() {return _fd;};
+
+	protected:
+		gnMsup1PosixTransport(gnMsup1PosixTransport::DirectionControl directionControl) : _device(nullptr), _directionControl(directionControl) {};
+		bool _configure(uint32_t baudRate);
+		size_t _fillRxBuffer();
+
+		const char*				_device;
+		DirectionControl	_directionControl;
+		int								_fd = -1;
+
+		// Bulk Receive Buffer; refilled with one non-blocking read() per Chunk
+		uint8_t						_rxBuffer[GNMSUP1_POSIX_RXBUFFER];
+		size_t						_rxHead = 0;
+		size_t						_rxTail = 0;
+};
+
+
+
+// Pseudo-Terminal Loopback Transport; open peerName() with a gnMsup1PosixTransport (DirectionNone) for the other Node
+class gnMsup1PtyTransport : public gnMsup1PosixTransport {
+	public:
+		gnMsup1PtyTransport() : gnMsup1PosixTransport(DirectionNone) {};
+
+		bool begin(uint32_t baudRate);
+		const char* peerName();
+
+	private:
+		char							_peerName[64];																							// Own Copy; ptsname() shares one static Buffer between all Instances
+};
+#endif
+#endif	// #ifndef gnMsup1Transport_h